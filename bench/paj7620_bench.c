@@ -0,0 +1,779 @@
+//*****************************************************************************
+// file        : paj7620_bench.c
+// host benchmark of the paj7620 gesture decode path
+//
+// The driver is built on the host against a fake i2c bus with zero latency
+// transfers. Every decode replays one sample of the interrupt flags: the
+// first read of PAJ_GET_INT_FLAG1 returns f1, the following ones return the
+// confirmation value f1c, PAJ_GET_INT_FLAG2 returns f2. The samples come
+// from a fixed seed random generator, from the scripted traces below and
+// optionally from a recording file.
+//
+// The flag registers clear on read, a wave left in PAJ_GET_INT_FLAG2 is
+// still there for the next sample. The gestures decoded by
+// paj7620_get_gesture() are checked against the original nested switch
+// decoder, kept verbatim in paj7620_reference.c, and the benchmark fails on
+// any mismatch. For both decoders it reports the time, the branch misses (when
+// the perf counters are available), the transactions, the bytes on the bus
+// and the confirmation delays per decode.
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+// 2026/10/19           agent       Clear the flags on read, run the original decoder verbatim.
+//
+//*****************************************************************************
+#define _GNU_SOURCE
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "paj7620.h"
+
+/**< registers served by the fake sensor */
+#define BENCH_BANK_SEL              0xef
+#define BENCH_INT_FLAG1             0x43
+#define BENCH_INT_FLAG2             0x44
+
+/**< flag values of the original decoder */
+#define BENCH_RIGHT_FLAG            0x01
+#define BENCH_LEFT_FLAG             0x02
+#define BENCH_UP_FLAG               0x04
+#define BENCH_DOWN_FLAG             0x08
+#define BENCH_FORWARD_FLAG          0x10
+#define BENCH_BACKWARD_FLAG         0x20
+#define BENCH_CLOCKWISE_FLAG        0x40
+#define BENCH_COUNT_CLOCKWISE_FLAG  0x80
+#define BENCH_WAVE_FLAG             0x01
+
+/**< number of distinct random samples, replayed in a loop */
+#define BENCH_SAMPLES               (1 << 16)
+
+/**< default number of timed decodes per decoder */
+#define BENCH_DEFAULT_DECODES       2000000
+
+/**< interrupt flags seen by one decode */
+struct bench_sample
+{
+    rt_uint8_t f1;
+    rt_uint8_t f2;
+    rt_uint8_t f1c;
+};
+
+/**< scripted traces, the corner cases of the decoder */
+static const struct bench_sample bench_script[] =
+{
+    {0x00, 0x00, 0x00},
+    {0x00, BENCH_WAVE_FLAG, 0x00},
+    {0x00, 0x02, 0x00},
+    {0x00, 0x03, 0x00},
+    {BENCH_RIGHT_FLAG, 0x00, 0x00},
+    {BENCH_RIGHT_FLAG, 0x00, BENCH_FORWARD_FLAG},
+    {BENCH_RIGHT_FLAG, 0x00, BENCH_BACKWARD_FLAG},
+    {BENCH_RIGHT_FLAG, 0x00, BENCH_FORWARD_FLAG | BENCH_BACKWARD_FLAG},
+    {BENCH_LEFT_FLAG, 0x00, BENCH_FORWARD_FLAG},
+    {BENCH_LEFT_FLAG, BENCH_WAVE_FLAG, BENCH_LEFT_FLAG},
+    {BENCH_UP_FLAG, 0x00, BENCH_BACKWARD_FLAG},
+    {BENCH_UP_FLAG, 0x00, BENCH_DOWN_FLAG},
+    {BENCH_DOWN_FLAG, 0x00, BENCH_FORWARD_FLAG},
+    {BENCH_DOWN_FLAG, 0x00, 0x00},
+    {BENCH_FORWARD_FLAG, 0x00, 0x00},
+    {BENCH_BACKWARD_FLAG, BENCH_WAVE_FLAG, 0x00},
+    {BENCH_CLOCKWISE_FLAG, 0x00, 0x00},
+    {BENCH_COUNT_CLOCKWISE_FLAG, 0x00, 0x00},
+    {BENCH_RIGHT_FLAG | BENCH_LEFT_FLAG, BENCH_WAVE_FLAG, 0x00},
+    {BENCH_FORWARD_FLAG | BENCH_BACKWARD_FLAG, 0x00, 0x00},
+    {0xff, 0xff, 0xff},
+    {BENCH_CLOCKWISE_FLAG, BENCH_WAVE_FLAG, 0x00},
+    {0x00, 0x00, 0x00},
+    {BENCH_UP_FLAG, BENCH_WAVE_FLAG, 0x00},
+    {BENCH_LEFT_FLAG, 0x00, 0x00},
+    {0x00, 0x00, 0x00},
+    {BENCH_FORWARD_FLAG, BENCH_WAVE_FLAG, 0x00},
+    {0x00, BENCH_WAVE_FLAG, 0x00},
+};
+
+/**< state of the fake sensor, the flag registers clear on read */
+static struct
+{
+    rt_uint8_t flag1[2];            /**< FLAG1 at the first read and after the confirmation delay */
+    rt_uint8_t flag1_reads;
+    rt_uint8_t flag2;               /**< FLAG2, stays latched until read */
+    rt_uint8_t bank;
+    rt_uint8_t pointer;
+} bench_chip;
+
+/**< bus and delay counters */
+static struct
+{
+    rt_uint64_t transactions;
+    rt_uint64_t bytes;
+    rt_uint64_t delays;
+} bench_count;
+
+static rt_tick_t bench_tick;
+
+static paj7620_device_t bench_dev;
+
+void paj7620_reference_decode(struct rt_i2c_bus_device *i2c, int *gest);
+
+/**
+ * @brief read one register of the fake sensor
+ *
+ * @param addr register address
+ *
+ * @return register value
+ */
+static rt_uint8_t bench_chip_read(rt_uint8_t addr)
+{
+    rt_uint8_t value;
+
+    if (bench_chip.bank != 0)
+    {
+        return 0;
+    }
+
+    switch (addr)
+    {
+    case 0x00:
+        return 0x20;
+
+    case 0x01:
+        return 0x76;
+
+    case BENCH_INT_FLAG1:
+        value = (bench_chip.flag1_reads < 2) ? bench_chip.flag1[bench_chip.flag1_reads] : 0;
+        bench_chip.flag1_reads++;
+        return value;
+
+    case BENCH_INT_FLAG2:
+        value = bench_chip.flag2;
+        bench_chip.flag2 = 0;
+        return value;
+
+    default:
+        return addr;
+    }
+}
+
+/**
+ * @brief zero latency transfer of the fake bus
+ *
+ * A one byte write sets the register pointer, a two byte write writes a
+ * register, a read returns consecutive registers from the pointer on.
+ */
+static rt_size_t bench_master_xfer(struct rt_i2c_bus_device *bus, struct rt_i2c_msg msgs[], rt_uint32_t num)
+{
+    rt_uint32_t i;
+    rt_uint16_t j;
+
+    bench_count.transactions++;
+
+    for (i = 0; i < num; i++)
+    {
+        /* the address byte and the payload */
+        bench_count.bytes += 1 + msgs[i].len;
+
+        if (msgs[i].flags & RT_I2C_RD)
+        {
+            for (j = 0; j < msgs[i].len; j++)
+            {
+                msgs[i].buf[j] = bench_chip_read(bench_chip.pointer++);
+            }
+        }
+        else
+        {
+            bench_chip.pointer = msgs[i].buf[0];
+
+            if (msgs[i].len > 1 && msgs[i].buf[0] == BENCH_BANK_SEL)
+            {
+                bench_chip.bank = msgs[i].buf[1];
+            }
+        }
+    }
+
+    return num;
+}
+
+static const struct rt_i2c_bus_device_ops bench_i2c_ops =
+{
+    bench_master_xfer
+};
+
+static struct rt_i2c_bus_device bench_i2c =
+{
+    {{"i2cb"}},
+    &bench_i2c_ops,
+};
+
+/**
+ * @brief present a sample to the fake sensor
+ *
+ * FLAG1 holds f1 and, after a first read, the f1c latched during the
+ * confirmation delay. An f1c nobody reads is gone by the next sample. f2
+ * adds to what is left in FLAG2 from the previous samples.
+ *
+ * @param sample interrupt flags of the next decode
+ */
+static void bench_chip_load(const struct bench_sample *sample)
+{
+    bench_chip.flag1[0] = sample->f1;
+    bench_chip.flag1[1] = sample->f1c;
+    bench_chip.flag1_reads = 0;
+    bench_chip.flag2 |= sample->f2;
+}
+
+/**
+ * @brief clear the flags latched by the fake sensor and the driver
+ */
+static void bench_chip_reset(void)
+{
+    bench_chip.flag2 = 0;
+    bench_dev->wave_latched = RT_FALSE;
+}
+
+/**
+ * @brief decode with the original driver, see paj7620_reference.c
+ */
+static rt_err_t bench_reference_decode(paj7620_gesture_t *gest)
+{
+    int gesture = *gest;
+
+    paj7620_reference_decode(&bench_i2c, &gesture);
+    *gest = (paj7620_gesture_t)gesture;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief fixed seed xorshift generator, the runs are reproducible
+ */
+static rt_uint32_t bench_random(rt_uint32_t *state)
+{
+    rt_uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return *state = x;
+}
+
+/**
+ * @brief draw one flag value, mostly valid gestures with some noise
+ */
+static rt_uint8_t bench_random_flag(rt_uint32_t *state, rt_uint8_t none_weight)
+{
+    rt_uint32_t r = bench_random(state) % 100;
+
+    if (r < none_weight)
+    {
+        return 0;
+    }
+
+    if (r < 90)
+    {
+        return 1 << (bench_random(state) % 8);
+    }
+
+    return bench_random(state) & 0xff;
+}
+
+/**
+ * @brief fill the sample table from the generator
+ */
+static void bench_generate(struct bench_sample *samples, rt_size_t count, rt_uint32_t seed)
+{
+    rt_size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        samples[i].f1 = bench_random_flag(&seed, 30);
+        samples[i].f2 = bench_random_flag(&seed, 60) & 0x01;
+        samples[i].f1c = bench_random_flag(&seed, 40);
+
+        /* the confirmation is mostly forward/backward or nothing */
+        if ((bench_random(&seed) % 4) == 0)
+        {
+            samples[i].f1c = (bench_random(&seed) & 1) ? BENCH_FORWARD_FLAG : BENCH_BACKWARD_FLAG;
+        }
+    }
+}
+
+/**
+ * @brief load a recording of "f1 f2 f1c" hex lines, '#' starts a comment
+ *
+ * @return number of samples loaded, -1 on error
+ */
+static long bench_load(const char *path, struct bench_sample **samples)
+{
+    unsigned int f1, f2, f1c;
+    rt_size_t count = 0, size = 0;
+    struct bench_sample *buf = RT_NULL, *tmp;
+    char line[128];
+    FILE *fp;
+
+    fp = fopen(path, "r");
+
+    if (fp == RT_NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp))
+    {
+        if (line[0] == '#' || sscanf(line, "%x %x %x", &f1, &f2, &f1c) != 3)
+        {
+            continue;
+        }
+
+        if (count == size)
+        {
+            size = size ? size * 2 : 256;
+            tmp = realloc(buf, size * sizeof(struct bench_sample));
+
+            if (tmp == RT_NULL)
+            {
+                free(buf);
+                fclose(fp);
+                return -1;
+            }
+
+            buf = tmp;
+        }
+
+        buf[count].f1 = f1;
+        buf[count].f2 = f2;
+        buf[count].f1c = f1c;
+        count++;
+    }
+
+    fclose(fp);
+    *samples = buf;
+
+    return count;
+}
+
+/**
+ * @brief open a branch miss counter of this thread
+ *
+ * @return counter file descriptor, -1 if perf counters aren't available
+ */
+static int bench_perf_open(void)
+{
+    struct perf_event_attr attr;
+
+    rt_memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/**< decoder under test */
+typedef rt_err_t (*bench_decoder_t)(paj7620_gesture_t *gest);
+
+static rt_err_t bench_driver_decode(paj7620_gesture_t *gest)
+{
+    return paj7620_get_gesture(bench_dev, gest);
+}
+
+/**
+ * @brief check the driver against the reference on every sample
+ *
+ * Each decoder replays the whole sequence on its own, so that the flags
+ * left latched by one sample reach the next one as on the real sensor.
+ *
+ * @return number of mismatches
+ */
+static rt_size_t bench_check(const char *name, const struct bench_sample *samples, rt_size_t count)
+{
+    paj7620_gesture_t *expect, got;
+    rt_size_t i, errors = 0;
+
+    expect = malloc(count * sizeof(paj7620_gesture_t));
+
+    if (expect == RT_NULL)
+    {
+        printf("%s: out of memory\n", name);
+        return 1;
+    }
+
+    bench_chip_reset();
+
+    for (i = 0; i < count; i++)
+    {
+        expect[i] = PAJ7620_GESTURE_NONE;
+        bench_chip_load(&samples[i]);
+        bench_reference_decode(&expect[i]);
+    }
+
+    bench_chip_reset();
+
+    for (i = 0; i < count; i++)
+    {
+        got = PAJ7620_GESTURE_NONE;
+        bench_chip_load(&samples[i]);
+
+        if (bench_driver_decode(&got) != RT_EOK)
+        {
+            got = -1;
+        }
+
+        if (expect[i] != got && errors++ < 10)
+        {
+            printf("%s sample %zu (%02x %02x %02x): reference %d, driver %d\n", name, i,
+                   samples[i].f1, samples[i].f2, samples[i].f1c, expect[i], got);
+        }
+    }
+
+    free(expect);
+
+    printf("%-10s %8zu samples checked, %zu mismatches\n", name, count, errors);
+
+    return errors;
+}
+
+/**
+ * @brief time a decoder over the samples
+ */
+static void bench_run(const char *name, bench_decoder_t decode, const struct bench_sample *samples,
+                      rt_size_t count, rt_uint64_t decodes, int perf_fd)
+{
+    struct timespec start, end;
+    paj7620_gesture_t gest;
+    rt_uint64_t i, misses = 0, sum = 0;
+    double ns;
+
+    rt_memset(&bench_count, 0, sizeof(bench_count));
+    bench_chip_reset();
+
+    if (perf_fd >= 0)
+    {
+        ioctl(perf_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (i = 0; i < decodes; i++)
+    {
+        bench_chip_load(&samples[i % count]);
+        decode(&gest);
+        sum += gest;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (perf_fd >= 0)
+    {
+        ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(perf_fd, &misses, sizeof(misses)) != sizeof(misses))
+        {
+            misses = 0;
+        }
+    }
+
+    ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+    printf("%-10s %8.1f ns/decode  ", name, ns / decodes);
+
+    if (perf_fd >= 0)
+    {
+        printf("%6.3f misses/decode  ", (double)misses / decodes);
+    }
+    else
+    {
+        printf("   n/a misses/decode  ");
+    }
+
+    printf("%5.3f xfers/decode  %6.2f bytes/decode  %5.3f delays/decode  (sum %llu)\n",
+           (double)bench_count.transactions / decodes, (double)bench_count.bytes / decodes,
+           (double)bench_count.delays / decodes, (unsigned long long)sum);
+}
+
+static void bench_usage(const char *name)
+{
+    printf("Usage: %s [-n decodes] [-s seed] [-f recording]\n", name);
+    printf("  -n decodes    number of timed decodes per decoder, default %d\n", BENCH_DEFAULT_DECODES);
+    printf("  -s seed       seed of the random samples\n");
+    printf("  -f recording  replay \"f1 f2 f1c\" hex lines instead of random samples\n");
+}
+
+int main(int argc, char *argv[])
+{
+    static struct bench_sample randoms[BENCH_SAMPLES];
+    struct bench_sample *samples = randoms;
+    rt_uint64_t decodes = BENCH_DEFAULT_DECODES;
+    rt_uint32_t seed = 0x7620;
+    const char *recording = RT_NULL;
+    rt_size_t errors;
+    long count = BENCH_SAMPLES;
+    int opt, perf_fd;
+
+    while ((opt = getopt(argc, argv, "n:s:f:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            decodes = strtoull(optarg, RT_NULL, 0);
+            break;
+
+        case 's':
+            seed = strtoul(optarg, RT_NULL, 0);
+            break;
+
+        case 'f':
+            recording = optarg;
+            break;
+
+        default:
+            bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (decodes == 0 || seed == 0)
+    {
+        bench_usage(argv[0]);
+        return 2;
+    }
+
+    bench_dev = paj7620_init(bench_i2c.parent.parent.name);
+
+    if (bench_dev == RT_NULL)
+    {
+        printf("paj7620_init failed on the fake bus\n");
+        return 1;
+    }
+
+    if (recording)
+    {
+        count = bench_load(recording, &samples);
+
+        if (count <= 0)
+        {
+            printf("no samples in '%s'\n", recording);
+            return 1;
+        }
+    }
+    else
+    {
+        bench_generate(randoms, BENCH_SAMPLES, seed);
+    }
+
+    errors = bench_check("script", bench_script, sizeof(bench_script) / sizeof(bench_script[0]));
+    errors += bench_check(recording ? "recording" : "random", samples, count);
+
+    if (errors)
+    {
+        return 1;
+    }
+
+    perf_fd = bench_perf_open();
+
+    bench_run("reference", bench_reference_decode, samples, count, decodes, perf_fd);
+    bench_run("driver", bench_driver_decode, samples, count, decodes, perf_fd);
+
+    if (perf_fd >= 0)
+    {
+        close(perf_fd);
+    }
+
+    paj7620_deinit(bench_dev);
+
+    return 0;
+}
+
+/**
+ * RT-Thread kernel services used by the driver. There is a single thread, so
+ * the locks always succeed, and the delays only count.
+ */
+
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
+{
+    return calloc(1, sizeof(struct rt_mutex));
+}
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
+{
+    mutex->hold = 0;
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_detach(rt_mutex_t mutex)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_delete(rt_mutex_t mutex)
+{
+    free(mutex);
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    mutex->hold++;
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    mutex->hold--;
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    sem->value = value;
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_detach(rt_sem_t sem)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    if (sem->value == 0)
+    {
+        return -RT_ETIMEOUT;
+    }
+
+    sem->value--;
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    sem->value++;
+    return RT_EOK;
+}
+
+rt_thread_t rt_thread_self(void)
+{
+    static struct rt_thread self;
+
+    return &self;
+}
+
+rt_err_t rt_thread_mdelay(rt_int32_t ms)
+{
+    bench_count.delays++;
+    bench_tick += ms;
+    return RT_EOK;
+}
+
+rt_tick_t rt_tick_get(void)
+{
+    return bench_tick;
+}
+
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms)
+{
+    return ms;
+}
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    return 0;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+}
+
+void rt_enter_critical(void)
+{
+}
+
+void rt_exit_critical(void)
+{
+}
+
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    return calloc(count, size);
+}
+
+void rt_free(void *ptr)
+{
+    free(ptr);
+}
+
+void rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+    printf("\n");
+}
+
+struct rt_i2c_bus_device *rt_i2c_bus_device_find(const char *bus_name)
+{
+    return rt_strcmp(bus_name, bench_i2c.parent.parent.name) ? RT_NULL : &bench_i2c;
+}
+
+rt_size_t rt_i2c_transfer(struct rt_i2c_bus_device *bus, struct rt_i2c_msg msgs[], rt_uint32_t num)
+{
+    rt_size_t ret;
+
+    rt_mutex_take(&bus->lock, RT_WAITING_FOREVER);
+    ret = bus->ops->master_xfer(bus, msgs, num);
+    rt_mutex_release(&bus->lock);
+
+    return ret;
+}
+
+void rt_pin_mode(rt_base_t pin, rt_base_t mode)
+{
+}
+
+rt_err_t rt_pin_attach_irq(rt_int32_t pin, rt_uint32_t mode, void (*hdr)(void *args), void *args)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_pin_detach_irq(rt_int32_t pin)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_pin_irq_enable(rt_base_t pin, rt_uint32_t enabled)
+{
+    return RT_EOK;
+}
+
+struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_size, rt_uint8_t priority)
+{
+    return RT_NULL;
+}
+
+rt_err_t rt_workqueue_submit_work(struct rt_workqueue *queue, struct rt_work *work, rt_tick_t time)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_workqueue_urgent_work(struct rt_workqueue *queue, struct rt_work *work)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_workqueue_cancel_work_sync(struct rt_workqueue *queue, struct rt_work *work)
+{
+    return RT_EOK;
+}
@@ -0,0 +1,267 @@
+//*****************************************************************************
+// file        : paj7620_reference.c
+// original paj7620 gesture decoder, the baseline of the benchmark
+//
+// paj7620_read_reg() and paj7620_get_gesture() below are verbatim copies of
+// the code before the decoder was reworked, including its four duplicated
+// direction branches and its RT_ERROR return on success. Only the
+// declarations they need from the original paj7620.c and paj7620.h are
+// repeated here, and paj7620_get_gesture() is renamed so that it links next
+// to the driver.
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+//
+//*****************************************************************************
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#define paj7620_get_gesture         paj7620_reference_get_gesture
+
+/**< paj7620 device address */
+#define PAJ7620_ID                  0x73
+
+#define PAJ_GET_INT_FLAG1           0x43
+#define PAJ_GET_INT_FLAG2           0x44
+
+#define PAJ7620_VAL(val, maskbit)   (val << maskbit)
+
+/**< gesture interrupt flag */
+#define GES_RIGHT_FLAG              PAJ7620_VAL(1, 0)
+#define GES_LEFT_FLAG               PAJ7620_VAL(1, 1)
+#define GES_UP_FLAG                 PAJ7620_VAL(1, 2)
+#define GES_DOWN_FLAG               PAJ7620_VAL(1, 3)
+#define GES_FORWARD_FLAG            PAJ7620_VAL(1, 4)
+#define GES_BACKWARD_FLAG           PAJ7620_VAL(1, 5)
+#define GES_CLOCKWISE_FLAG          PAJ7620_VAL(1, 6)
+#define GES_COUNT_CLOCKWISE_FLAG    PAJ7620_VAL(1, 7)
+#define GES_WAVE_FLAG               PAJ7620_VAL(1, 0)
+
+struct paj7620_device
+{
+    struct rt_i2c_bus_device *i2c;
+    rt_mutex_t lock;
+};
+typedef struct paj7620_device *paj7620_device_t;
+
+typedef enum
+{
+    PAJ7620_GESTURE_UP,
+    PAJ7620_GESTURE_DOWN,
+    PAJ7620_GESTURE_LEFT,
+    PAJ7620_GESTURE_RIGHT,
+    PAJ7620_GESTURE_FORWARD,
+    PAJ7620_GESTURE_BACKWARD,
+    PAJ7620_GESTURE_CLOCKWISE,
+    PAJ7620_GESTURE_ANTICLOCKWISE,
+    PAJ7620_GESTURE_WAVE,
+    PAJ7620_GESTURE_NONE
+} paj7620_gesture_t;
+
+rt_err_t paj7620_get_gesture(paj7620_device_t dev, paj7620_gesture_t *gest);
+
+/**
+ * @brief read paj7620 register value
+ *
+ * @param dev device handle
+ * @param addr register address
+ * @param data the read data
+ *
+ * @return operation result
+ */
+static rt_err_t paj7620_read_reg(paj7620_device_t dev, rt_uint8_t addr, rt_uint8_t *data)
+{
+    struct rt_i2c_msg msgs[2];
+
+    msgs[0].addr = PAJ7620_ID;
+    msgs[0].flags = RT_I2C_WR;
+    msgs[0].buf = &addr;
+    msgs[0].len = 1;
+
+    msgs[1].addr = PAJ7620_ID;
+    msgs[1].flags = RT_I2C_RD;
+    msgs[1].buf = data;
+    msgs[1].len = 1;
+
+    if (rt_i2c_transfer(dev->i2c, msgs, 2) == 0)
+    {
+        return RT_ERROR;
+    }
+    else
+    {
+        return RT_EOK;
+    }
+}
+
+/**
+ * @brief get gesture
+ *
+ * @param dev device handle
+ * @param gest the gesture state read from register
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_get_gesture(paj7620_device_t dev, paj7620_gesture_t *gest)
+{
+    rt_uint8_t gesture;
+
+    if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG1, &gesture) == RT_EOK)
+    {
+        switch (gesture)
+        {
+        case GES_RIGHT_FLAG:
+            rt_thread_mdelay(1);
+
+            if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG1, &gesture) == RT_EOK)
+            {
+                if (gesture == GES_FORWARD_FLAG)
+                {
+                    *gest = PAJ7620_GESTURE_FORWARD;
+                }
+                else if (gesture == GES_BACKWARD_FLAG)
+                {
+                    *gest = PAJ7620_GESTURE_BACKWARD;
+                }
+                else
+                {
+                    *gest = PAJ7620_GESTURE_RIGHT;
+                }
+            }
+            else
+            {
+                return RT_ERROR;
+            }
+            break;
+
+        case GES_LEFT_FLAG:
+            rt_thread_mdelay(1);
+
+            if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG1, &gesture) == RT_EOK)
+            {
+                if (gesture == GES_FORWARD_FLAG)
+                {
+                    *gest = PAJ7620_GESTURE_FORWARD;
+                }
+                else if (gesture == GES_BACKWARD_FLAG)
+                {
+                    *gest = PAJ7620_GESTURE_BACKWARD;
+                }
+                else
+                {
+                    *gest = PAJ7620_GESTURE_LEFT;
+                }
+            }
+            else
+            {
+                return RT_ERROR;
+            }
+            break;
+
+        case GES_UP_FLAG:
+            rt_thread_mdelay(1);
+
+            if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG1, &gesture) == RT_EOK)
+            {
+                if (gesture == GES_FORWARD_FLAG)
+                {
+                    *gest = PAJ7620_GESTURE_FORWARD;
+                }
+                else if (gesture == GES_BACKWARD_FLAG)
+                {
+                    *gest = PAJ7620_GESTURE_BACKWARD;
+                }
+                else
+                {
+                    *gest = PAJ7620_GESTURE_UP;
+                }
+            }
+            else
+            {
+                return RT_ERROR;
+            }
+            break;
+
+        case GES_DOWN_FLAG:
+            rt_thread_mdelay(1);
+
+            if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG1, &gesture) == RT_EOK)
+            {
+                if (gesture == GES_FORWARD_FLAG)
+                {
+                    *gest = PAJ7620_GESTURE_FORWARD;
+                }
+                else if (gesture == GES_BACKWARD_FLAG)
+                {
+                    *gest = PAJ7620_GESTURE_BACKWARD;
+                }
+                else
+                {
+                    *gest = PAJ7620_GESTURE_DOWN;
+                }
+            }
+            else
+            {
+                return RT_ERROR;
+            }
+            break;
+
+        case GES_FORWARD_FLAG:
+            *gest = PAJ7620_GESTURE_FORWARD;
+            break;
+
+        case GES_BACKWARD_FLAG:
+            *gest = PAJ7620_GESTURE_BACKWARD;
+            break;
+
+        case GES_CLOCKWISE_FLAG:
+            *gest = PAJ7620_GESTURE_CLOCKWISE;
+            break;
+
+        case GES_COUNT_CLOCKWISE_FLAG:
+            *gest = PAJ7620_GESTURE_ANTICLOCKWISE;
+            break;
+
+        default:
+            if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG2, &gesture) == RT_EOK)
+            {
+                if (gesture == GES_WAVE_FLAG)
+                {
+                    *gest = PAJ7620_GESTURE_WAVE;
+                }
+                else
+                {
+                    *gest = PAJ7620_GESTURE_NONE;
+                }
+            }
+            else
+            {
+                return RT_ERROR;
+            }
+            break;
+        }
+    }
+    else
+    {
+        return RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * @brief run the original decoder on a bus
+ *
+ * @param i2c i2c bus device
+ * @param gest the decoded gesture, left untouched if nothing was read
+ */
+void paj7620_reference_decode(struct rt_i2c_bus_device *i2c, int *gest)
+{
+    struct paj7620_device dev = {i2c, RT_NULL};
+    paj7620_gesture_t gesture = (paj7620_gesture_t)*gest;
+
+    /* the result is RT_ERROR even on success, only the gesture counts */
+    paj7620_get_gesture(&dev, &gesture);
+
+    *gest = gesture;
+}
@@ -0,0 +1,13 @@
+//*****************************************************************************
+// file        : rtdbg.h
+// minimal host stand-in of the RT-Thread log macros for the benchmark
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+//
+//*****************************************************************************
+#define LOG_E(...)                  rt_kprintf(__VA_ARGS__)
+#define LOG_W(...)                  rt_kprintf(__VA_ARGS__)
+#define LOG_I(...)
+#define LOG_D(...)
@@ -0,0 +1,79 @@
+//*****************************************************************************
+// file        : rtdevice.h
+// minimal host stand-in of the RT-Thread device API for the benchmark
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+//
+//*****************************************************************************
+#ifndef __BENCH_RTDEVICE_H__
+#define __BENCH_RTDEVICE_H__
+
+#include <rtthread.h>
+
+#define RT_I2C_WR                   0x0000
+#define RT_I2C_RD                   (1u << 0)
+
+struct rt_i2c_msg
+{
+    rt_uint16_t addr;
+    rt_uint16_t flags;
+    rt_uint16_t len;
+    rt_uint8_t  *buf;
+};
+
+struct rt_i2c_bus_device;
+
+struct rt_i2c_bus_device_ops
+{
+    rt_size_t (*master_xfer)(struct rt_i2c_bus_device *bus, struct rt_i2c_msg msgs[], rt_uint32_t num);
+};
+
+struct rt_device
+{
+    struct rt_object parent;
+};
+
+struct rt_i2c_bus_device
+{
+    struct rt_device parent;
+    const struct rt_i2c_bus_device_ops *ops;
+    struct rt_mutex lock;
+};
+
+struct rt_i2c_bus_device *rt_i2c_bus_device_find(const char *bus_name);
+rt_size_t rt_i2c_transfer(struct rt_i2c_bus_device *bus, struct rt_i2c_msg msgs[], rt_uint32_t num);
+
+#define PIN_MODE_INPUT_PULLUP       2
+#define PIN_IRQ_MODE_FALLING        1
+#define PIN_IRQ_DISABLE             0
+#define PIN_IRQ_ENABLE              1
+
+void rt_pin_mode(rt_base_t pin, rt_base_t mode);
+rt_err_t rt_pin_attach_irq(rt_int32_t pin, rt_uint32_t mode, void (*hdr)(void *args), void *args);
+rt_err_t rt_pin_detach_irq(rt_int32_t pin);
+rt_err_t rt_pin_irq_enable(rt_base_t pin, rt_uint32_t enabled);
+
+struct rt_workqueue;
+
+struct rt_work
+{
+    void (*work_func)(struct rt_work *work, void *work_data);
+    void *work_data;
+};
+
+static inline void rt_work_init(struct rt_work *work,
+                                void (*work_func)(struct rt_work *work, void *work_data),
+                                void *work_data)
+{
+    work->work_func = work_func;
+    work->work_data = work_data;
+}
+
+struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_size, rt_uint8_t priority);
+rt_err_t rt_workqueue_submit_work(struct rt_workqueue *queue, struct rt_work *work, rt_tick_t time);
+rt_err_t rt_workqueue_urgent_work(struct rt_workqueue *queue, struct rt_work *work);
+rt_err_t rt_workqueue_cancel_work_sync(struct rt_workqueue *queue, struct rt_work *work);
+
+#endif //  __BENCH_RTDEVICE_H__
@@ -0,0 +1,142 @@
+//*****************************************************************************
+// file        : rtthread.h
+// minimal host stand-in of the RT-Thread kernel API for the benchmark
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+//
+//*****************************************************************************
+#ifndef __BENCH_RTTHREAD_H__
+#define __BENCH_RTTHREAD_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef int8_t                      rt_int8_t;
+typedef int16_t                     rt_int16_t;
+typedef int32_t                     rt_int32_t;
+typedef int64_t                     rt_int64_t;
+typedef uint8_t                     rt_uint8_t;
+typedef uint16_t                    rt_uint16_t;
+typedef uint32_t                    rt_uint32_t;
+typedef uint64_t                    rt_uint64_t;
+typedef long                        rt_base_t;
+typedef unsigned long               rt_ubase_t;
+typedef rt_base_t                   rt_err_t;
+typedef rt_uint32_t                 rt_tick_t;
+typedef rt_ubase_t                  rt_size_t;
+typedef rt_base_t                   rt_off_t;
+typedef int                         rt_bool_t;
+
+#define RT_TRUE                     1
+#define RT_FALSE                    0
+#define RT_NULL                     ((void *)0)
+
+#define RT_EOK                      0
+#define RT_ERROR                    1
+#define RT_ETIMEOUT                 2
+#define RT_EFULL                    3
+#define RT_EEMPTY                   4
+#define RT_ENOMEM                   5
+#define RT_ENOSYS                   6
+#define RT_EBUSY                    7
+#define RT_EIO                      8
+#define RT_EINVAL                   10
+
+#define RT_WAITING_FOREVER          -1
+#define RT_WAITING_NO               0
+#define RT_TICK_PER_SECOND          1000
+#define RT_NAME_MAX                 8
+#define RT_IPC_FLAG_FIFO            0x00
+#define RT_IPC_FLAG_PRIO            0x01
+
+#define RT_ASSERT(EX)               ((void)(EX))
+
+struct rt_list_node
+{
+    struct rt_list_node *next;
+    struct rt_list_node *prev;
+};
+typedef struct rt_list_node rt_list_t;
+
+#define RT_LIST_OBJECT_INIT(object) { &(object), &(object) }
+#define rt_list_entry(node, type, member) \
+    ((type *)((char *)(node) - (unsigned long)(&((type *)0)->member)))
+#define rt_list_for_each_entry(pos, head, member) \
+    for (pos = rt_list_entry((head)->next, __typeof__(*pos), member); \
+         &pos->member != (head); \
+         pos = rt_list_entry(pos->member.next, __typeof__(*pos), member))
+
+static inline void rt_list_insert_before(rt_list_t *l, rt_list_t *n)
+{
+    l->prev->next = n;
+    n->prev = l->prev;
+    l->prev = n;
+    n->next = l;
+}
+
+static inline void rt_list_remove(rt_list_t *n)
+{
+    n->next->prev = n->prev;
+    n->prev->next = n->next;
+    n->next = n->prev = n;
+}
+
+struct rt_object
+{
+    char name[RT_NAME_MAX];
+};
+
+struct rt_mutex
+{
+    struct rt_object parent;
+    rt_uint16_t hold;
+};
+typedef struct rt_mutex *rt_mutex_t;
+
+struct rt_semaphore
+{
+    struct rt_object parent;
+    rt_uint16_t value;
+};
+typedef struct rt_semaphore *rt_sem_t;
+
+struct rt_thread
+{
+    struct rt_object parent;
+};
+typedef struct rt_thread *rt_thread_t;
+
+rt_thread_t rt_thread_self(void);
+
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_detach(rt_mutex_t mutex);
+rt_err_t rt_mutex_delete(rt_mutex_t mutex);
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time);
+rt_err_t rt_mutex_release(rt_mutex_t mutex);
+
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag);
+rt_err_t rt_sem_detach(rt_sem_t sem);
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time);
+rt_err_t rt_sem_release(rt_sem_t sem);
+
+rt_err_t rt_thread_mdelay(rt_int32_t ms);
+rt_tick_t rt_tick_get(void);
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms);
+rt_base_t rt_hw_interrupt_disable(void);
+void rt_hw_interrupt_enable(rt_base_t level);
+void rt_enter_critical(void);
+void rt_exit_critical(void);
+
+void *rt_calloc(rt_size_t count, rt_size_t size);
+void rt_free(void *ptr);
+#define rt_memset                   memset
+#define rt_memcpy                   memcpy
+#define rt_strcmp                   strcmp
+
+void rt_kprintf(const char *fmt, ...);
+
+#endif //  __BENCH_RTTHREAD_H__
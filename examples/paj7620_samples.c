@@ -6,6 +6,13 @@
 // Change Logs:
 // Date                 Author      Note
 // 2020/07/08           Cheney      First draft version
+// 2026/10/19           agent       Use the workqueue engine instead of a thread.
+// 2026/10/19           agent       Support several devices, add the tuning commands.
+// 2026/10/19           agent       Add the concurrent scan of several buses.
+// 2026/10/19           agent       Replace mode and rate by reset, keep the flags out of dump.
+// 2026/10/19           agent       Restore the mode and rate commands.
+// 2026/10/19           agent       Leave the engine and the callback of watch as they were.
+// 2026/10/19           agent       Print the BSP clock instead of 0 Hz in list.
 //
 //*****************************************************************************
 
@@ -15,13 +22,20 @@
 //! @{
 //
 //*****************************************************************************
+#include <stdlib.h>
 #include "paj7620.h"
 
 #ifdef PAJ7620_USING_SAMPLES
-/**< test thread handle */
-static rt_thread_t tid1 = RT_NULL;
 
-/**< test device handle */
+/**< number of devices the msh command can handle */
+#ifndef PAJ7620_SAMPLE_DEVICES
+#define PAJ7620_SAMPLE_DEVICES      4
+#endif
+
+/**< probed device handles */
+static paj7620_device_t test_devs[PAJ7620_SAMPLE_DEVICES];
+
+/**< device the commands apply to */
 static paj7620_device_t test_dev = RT_NULL;
 
 char *gesture_string[] =
@@ -38,28 +52,281 @@ char *gesture_string[] =
 };
 
 /**
- * @brief paj7620 gesture detection thread
+ * @brief print a gesture event
  *
- * @param parameter input paramters
+ * @param event gesture event
  */
-static void paj7620_entry(void *parameter)
+static void paj7620_print_event(const struct paj7620_gesture_event *event)
 {
-    paj7620_gesture_t gesture;
+    rt_kprintf("[%u] %s: speed %d, size %d, brightness %d, waves %d, confidence %d%%\r\n",
+               event->timestamp, gesture_string[event->type], event->speed,
+               event->object_size, event->brightness, event->wave_count, event->confidence);
+}
+
+/**
+ * @brief print the gestures queued by the engine
+ *
+ * @param dev device handle
+ */
+static void paj7620_indicate(paj7620_device_t dev)
+{
+    struct paj7620_gesture_event event;
+
+    while (paj7620_wait_event(dev, &event, RT_WAITING_NO) == RT_EOK)
+    {
+        rt_kprintf("%s ", dev->i2c->parent.parent.name);
+        paj7620_print_event(&event);
+    }
+}
+
+/**
+ * @brief find a probed device by its i2c bus name
+ *
+ * @param name i2c bus name
+ *
+ * @return device slot, RT_NULL if the device wasn't probed
+ */
+static paj7620_device_t *paj7620_sample_find(const char *name)
+{
+    rt_uint8_t i;
+
+    for (i = 0; i < PAJ7620_SAMPLE_DEVICES; i++)
+    {
+        if (test_devs[i] && !rt_strcmp(test_devs[i]->i2c->parent.parent.name, name))
+        {
+            return &test_devs[i];
+        }
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * @brief probe a device and make it the current one
+ *
+ * @param name i2c bus name
+ */
+static void paj7620_sample_probe(const char *name)
+{
+    paj7620_device_t *slot;
+
+    slot = paj7620_sample_find(name);
+
+    if (slot == RT_NULL)
+    {
+        /* look for a free slot */
+        for (slot = &test_devs[0]; slot < &test_devs[PAJ7620_SAMPLE_DEVICES] && *slot; slot++);
+
+        if (slot == &test_devs[PAJ7620_SAMPLE_DEVICES])
+        {
+            rt_kprintf("no room for another paj7620, remove one first\n");
+            return;
+        }
+
+        *slot = paj7620_init(name);
+    }
+
+    if (*slot)
+    {
+        test_dev = *slot;
+    }
+}
+
+/**
+ * @brief probe several buses concurrently and keep the sensors found
+ *
+ * @param names i2c bus names
+ * @param count number of names
+ */
+static void paj7620_sample_scan(char *names[], rt_size_t count)
+{
+    struct paj7620_probe probes[PAJ7620_SAMPLE_DEVICES];
+    paj7620_device_t *slot = &test_devs[0];
+    rt_size_t i, n = 0;
+
+    rt_memset(probes, 0, sizeof(probes));
 
-    while (1)
+    for (i = 0; i < count && n < PAJ7620_SAMPLE_DEVICES; i++)
     {
-        if (paj7620_get_gesture(test_dev, &gesture) == RT_EOK)
+        if (paj7620_sample_find(names[i]) == RT_NULL)
         {
-            if (gesture < PAJ7620_GESTURE_NONE)
+            probes[n++].bus_name = names[i];
+        }
+    }
+
+    rt_kprintf("%d paj7620 found\n", (int)paj7620_discover(probes, n));
+
+    for (i = 0; i < n; i++)
+    {
+        if (probes[i].dev == RT_NULL)
+        {
+            continue;
+        }
+
+        for (; slot < &test_devs[PAJ7620_SAMPLE_DEVICES] && *slot; slot++);
+
+        if (slot == &test_devs[PAJ7620_SAMPLE_DEVICES])
+        {
+            rt_kprintf("no room for the paj7620 on '%s'\n", probes[i].bus_name);
+            paj7620_deinit(probes[i].dev);
+            continue;
+        }
+
+        *slot = probes[i].dev;
+        test_dev = *slot;
+    }
+}
+
+/**
+ * @brief remove a probed device
+ *
+ * @param name i2c bus name
+ */
+static void paj7620_sample_remove(const char *name)
+{
+    paj7620_device_t *slot;
+
+    slot = paj7620_sample_find(name);
+
+    if (slot == RT_NULL)
+    {
+        rt_kprintf("paj7620 on '%s' not probed\n", name);
+        return;
+    }
+
+    if (test_dev == *slot)
+    {
+        test_dev = RT_NULL;
+    }
+
+    paj7620_deinit(*slot);
+    *slot = RT_NULL;
+}
+
+/**
+ * @brief dump a register bank with burst reads
+ *
+ * @param bank register bank
+ */
+static void paj7620_sample_dump(rt_uint8_t bank)
+{
+    rt_uint8_t buf[16];
+    rt_uint16_t addr;
+    rt_uint8_t i;
+
+    rt_kprintf("bank%d  00 01 02 03 04 05 06 07 08 09 0a 0b 0c 0d 0e 0f\n", bank);
+
+    for (addr = 0; addr < 0x100; addr += sizeof(buf))
+    {
+        if (bank == 0 && addr == 0x40)
+        {
+            /* the interrupt flags 0x43 and 0x44 clear on read, a dump would eat a gesture */
+            if (paj7620_read_bank_regs(test_dev, bank, addr, buf, 3) != RT_EOK ||
+                paj7620_read_bank_regs(test_dev, bank, addr + 5, &buf[5], sizeof(buf) - 5) != RT_EOK)
+            {
+                rt_kprintf("read bank%d 0x%02x failed\n", bank, addr);
+                return;
+            }
+        }
+        else if (paj7620_read_bank_regs(test_dev, bank, addr, buf, sizeof(buf)) != RT_EOK)
+        {
+            rt_kprintf("read bank%d 0x%02x failed\n", bank, addr);
+            return;
+        }
+
+        rt_kprintf("0x%02x: ", addr);
+
+        for (i = 0; i < sizeof(buf); i++)
+        {
+            if (bank == 0 && (addr + i == 0x43 || addr + i == 0x44))
+            {
+                rt_kprintf(" --");
+            }
+            else
             {
-                rt_kprintf("Detected gesture: %s\r\n", gesture_string[gesture]);
+                rt_kprintf(" %02x", buf[i]);
             }
         }
 
-        rt_thread_mdelay(50);
+        rt_kprintf("\n");
     }
 }
 
+/**
+ * @brief stream the gestures of the current device
+ *
+ * @param seconds watch duration
+ */
+static void paj7620_sample_watch(rt_int32_t seconds)
+{
+    void (*indicate)(paj7620_device_t dev) = test_dev->indicate;
+    struct paj7620_gesture_event event;
+    rt_bool_t started = RT_FALSE;
+    rt_int32_t remain;
+    rt_tick_t end;
+
+    if (!test_dev->running)
+    {
+        if (paj7620_start(test_dev, RT_NULL, -1) != RT_EOK)
+        {
+            rt_kprintf("can't start paj7620 gesture detection\n");
+            return;
+        }
+
+        started = RT_TRUE;
+    }
+
+    /* the events are printed here, not by the indicate callback */
+    paj7620_set_indicate(test_dev, RT_NULL);
+
+    end = rt_tick_get() + rt_tick_from_millisecond(seconds * 1000);
+
+    for (;;)
+    {
+        /* computed once, a second read could pass the end and wait forever */
+        remain = (rt_int32_t)(end - rt_tick_get());
+
+        if (remain <= 0)
+        {
+            break;
+        }
+
+        if (paj7620_wait_event(test_dev, &event, remain) == RT_EOK)
+        {
+            paj7620_print_event(&event);
+        }
+    }
+
+    if (started)
+    {
+        paj7620_stop(test_dev);
+    }
+
+    paj7620_set_indicate(test_dev, indicate);
+}
+
+/**
+ * @brief print the msh command usage
+ */
+static void paj7620_usage(void)
+{
+    rt_kprintf("Usage:\n");
+    rt_kprintf("paj7620 probe <dev_name>          - probe paj7620 by given name and use it\n");
+    rt_kprintf("paj7620 scan <dev_name>...        - probe several buses at once\n");
+    rt_kprintf("paj7620 use <dev_name>            - run the next commands on a probed paj7620\n");
+    rt_kprintf("paj7620 remove <dev_name>         - deinitialize a probed paj7620\n");
+    rt_kprintf("paj7620 list                      - list the probed paj7620\n");
+    rt_kprintf("paj7620 open [int_pin]            - open paj7620 gesture detection\n");
+    rt_kprintf("paj7620 close                     - close paj7620 gesture detection\n");
+    rt_kprintf("paj7620 dump <bank>               - dump a register bank\n");
+    rt_kprintf("paj7620 set <bank> <reg> <val>    - write a register, kept across reloads\n");
+    rt_kprintf("paj7620 reset                     - drop the written registers, reload the defaults\n");
+    rt_kprintf("paj7620 mode <mode>               - gesture restores the gesture setting,\n");
+    rt_kprintf("                                    proximity and cursor are not supported\n");
+    rt_kprintf("paj7620 rate normal|gaming        - set the gesture report rate (120/240 fps)\n");
+    rt_kprintf("paj7620 watch [seconds]           - stream gestures and object data\n");
+}
+
 /**
  * @brief paj7620 msh command
  *
@@ -68,57 +335,159 @@ static void paj7620_entry(void *parameter)
  */
 void paj7620(int argc, char *argv[])
 {
-    if (argc > 1)
+    paj7620_device_t *slot;
+    rt_uint8_t i;
+
+    if (argc < 2)
+    {
+        paj7620_usage();
+        return;
+    }
+
+    if (!rt_strcmp(argv[1], "probe") || !rt_strcmp(argv[1], "use") || !rt_strcmp(argv[1], "remove"))
     {
-        if (!rt_strcmp(argv[1], "probe"))
+        if (argc < 3)
+        {
+            paj7620_usage();
+        }
+        else if (!rt_strcmp(argv[1], "probe"))
+        {
+            paj7620_sample_probe(argv[2]);
+        }
+        else if (!rt_strcmp(argv[1], "use"))
         {
-            if (argc > 2)
+            slot = paj7620_sample_find(argv[2]);
+
+            if (slot)
             {
-                /* initialize the sensor when first probe */
-                if (!test_dev || rt_strcmp(test_dev->i2c->parent.parent.name, argv[2]))
-                {
-                    /* deinit the old device */
-                    if (test_dev)
-                    {
-                        paj7620_deinit(test_dev);
-                    }
-
-                    test_dev = paj7620_init(argv[2]);
-                }
+                test_dev = *slot;
             }
             else
             {
-                rt_kprintf("paj7620 probe <dev_name> - probe sensor by given name\n");
+                rt_kprintf("paj7620 on '%s' not probed\n", argv[2]);
             }
         }
-        else if (!rt_strcmp(argv[1], "open"))
+        else
+        {
+            paj7620_sample_remove(argv[2]);
+        }
+
+        return;
+    }
+
+    if (!rt_strcmp(argv[1], "scan"))
+    {
+        if (argc < 3)
         {
-            if (test_dev)
+            paj7620_usage();
+        }
+        else
+        {
+            paj7620_sample_scan(&argv[2], argc - 2);
+        }
+
+        return;
+    }
+
+    if (!rt_strcmp(argv[1], "list"))
+    {
+        for (i = 0; i < PAJ7620_SAMPLE_DEVICES; i++)
+        {
+            if (test_devs[i] == RT_NULL)
             {
-                tid1 = rt_thread_create("paj7620", paj7620_entry, RT_NULL, 1024, 20, 1);
+                continue;
+            }
 
-                if (tid1 != RT_NULL)
-                {
-                    rt_thread_startup(tid1);
-                }
+            rt_kprintf("%c %s ", (test_devs[i] == test_dev) ? '*' : ' ',
+                       test_devs[i]->i2c->parent.parent.name);
+
+            if (test_devs[i]->clock)
+            {
+                rt_kprintf("%d Hz", test_devs[i]->clock);
+            }
+            else
+            {
+                rt_kprintf("BSP clock");
             }
+
+            rt_kprintf("%s\n", test_devs[i]->running ? " running" : "");
+        }
+
+        return;
+    }
+
+    if (test_dev == RT_NULL)
+    {
+        rt_kprintf("probe a paj7620 first\n");
+        return;
+    }
+
+    if (!rt_strcmp(argv[1], "open"))
+    {
+        paj7620_set_indicate(test_dev, paj7620_indicate);
+        paj7620_start(test_dev, RT_NULL, (argc > 2) ? atoi(argv[2]) : -1);
+    }
+    else if (!rt_strcmp(argv[1], "close"))
+    {
+        paj7620_stop(test_dev);
+    }
+    else if (!rt_strcmp(argv[1], "dump") && argc > 2)
+    {
+        paj7620_sample_dump(strtoul(argv[2], RT_NULL, 0));
+    }
+    else if (!rt_strcmp(argv[1], "set") && argc > 4)
+    {
+        if (paj7620_write_bank_reg(test_dev, strtoul(argv[2], RT_NULL, 0), strtoul(argv[3], RT_NULL, 0),
+                                   strtoul(argv[4], RT_NULL, 0)) != RT_EOK)
+        {
+            rt_kprintf("write failed\n");
         }
-        else if (!rt_strcmp(argv[1], "close"))
+    }
+    else if (!rt_strcmp(argv[1], "reset"))
+    {
+        paj7620_clear_overrides(test_dev);
+
+        if (paj7620_reload(test_dev) != RT_EOK)
+        {
+            rt_kprintf("reload failed\n");
+        }
+    }
+    else if (!rt_strcmp(argv[1], "mode") && argc > 2)
+    {
+        if (!rt_strcmp(argv[2], "gesture"))
         {
-            if (tid1 != RT_NULL)
+            if (paj7620_reload(test_dev) != RT_EOK)
             {
-                rt_thread_delete(tid1);
-                tid1 = RT_NULL;
+                rt_kprintf("reload failed\n");
             }
         }
+        else if (!rt_strcmp(argv[2], "proximity") || !rt_strcmp(argv[2], "cursor"))
+        {
+            /* the driver only carries the register table of the gesture mode */
+            rt_kprintf("mode '%s' is not supported, no register table for it\n", argv[2]);
+        }
         else
         {
-            rt_kprintf("Usage:\n");
-            rt_kprintf("paj7620 probe <dev_name>   - probe paj7620 by given name\n");
-            rt_kprintf("paj7620 open               - open paj7620 gesture detection\n");
-            rt_kprintf("paj7620 close              - close paj7620 gesture detection\n");
+            paj7620_usage();
+        }
+    }
+    else if (!rt_strcmp(argv[1], "rate") && argc > 2 &&
+             (!rt_strcmp(argv[2], "normal") || !rt_strcmp(argv[2], "gaming")))
+    {
+        if (paj7620_set_rate(test_dev, rt_strcmp(argv[2], "gaming") ? PAJ7620_RATE_NORMAL
+                                                                    : PAJ7620_RATE_GAMING) != RT_EOK)
+        {
+            rt_kprintf("set rate failed\n");
         }
     }
+    else if (!rt_strcmp(argv[1], "watch"))
+    {
+        paj7620_sample_watch((argc > 2) ? atoi(argv[2]) : 10);
+    }
+    else
+    {
+        paj7620_usage();
+    }
 }
 MSH_CMD_EXPORT(paj7620, paj7620 gesture function);
 #endif
@@ -128,4 +497,4 @@ MSH_CMD_EXPORT(paj7620, paj7620 gesture function);
 // Close the Doxygen group.
 //! @}
 //
-//*****************************************************************************
\ No newline at end of file
+//*****************************************************************************
@@ -7,6 +7,23 @@
 // 2020/07/05           Cheney      First draft version
 // 2020/07/07           Cheney      Fix the bug and update the sample macro.
 // 2020/07/08           Cheney      Move out the sample code to a separate file.
+// 2026/10/19           agent       Negotiate the i2c bus clock and retry failed transfers.
+// 2026/10/19           agent       Route register accesses through the bus scheduler.
+// 2026/10/19           agent       Run the gesture detection as workqueue items.
+// 2026/10/19           agent       Collect the gesture metadata with the flags.
+// 2026/10/19           agent       Run the gesture events through the filter pipeline.
+// 2026/10/19           agent       Verify the configuration with burst reads and a crc.
+// 2026/10/19           agent       Add wake-on-gesture for MCU deep sleep.
+// 2026/10/19           agent       Cache the selected bank, add register access and rate APIs.
+// 2026/10/19           agent       Add the object read for the sensor framework device.
+// 2026/10/19           agent       Release the device when the initialization fails.
+// 2026/10/19           agent       Read the wake gesture on the workqueue, not in the interrupt.
+// 2026/10/19           agent       Keep the register overrides across reloads.
+// 2026/10/19           agent       Add the cheap detection of the hot-plug check.
+// 2026/10/19           agent       Keep a wave latched during the forward/backward confirmation.
+// 2026/10/19           agent       Never queue the running flag read without delay.
+// 2026/10/19           agent       Restore the report rates with the documented idle times.
+// 2026/10/19           agent       Don't report a 0 Hz clock when the BSP clock is kept.
 //
 //*****************************************************************************
 
@@ -43,9 +60,12 @@
 #define PAJ_GET_OBJECT_BRIGHTNESS   0xB0
 #define PAJ_GET_OBJECT_SIZE_1       0xB1
 #define PAJ_GET_OBJECT_SIZE_2       0xB2
+#define PAJ_GET_WAVE_COUNT          0xB7
 
 /**< band1 register group */
 #define PAJ_SET_PS_GAIN             0x44
+#define PAJ_SET_IDLE_TIME_0         0x65
+#define PAJ_SET_IDLE_TIME_1         0x66
 #define PAJ_SET_IDLE_S1_STEP_0      0x67
 #define PAJ_SET_IDLE_S1_STEP_1      0x68
 #define PAJ_SET_IDLE_S2_STEP_0      0x69
@@ -75,7 +95,10 @@ typedef enum
     PAJ7620_BANK1
 } paj7620_bank_t;
 
-static rt_uint8_t paj7620_init_regs[][2] =
+/**< cached bank when the selection on the chip isn't known */
+#define PAJ7620_BANK_UNKNOWN        0xff
+
+static const rt_uint8_t paj7620_init_regs[][2] =
 {
     {0xEF, 0x00},
     {0x32, 0x29},
@@ -299,36 +322,98 @@ static rt_uint8_t paj7620_init_regs[][2] =
 };
 
 /**
- * @brief read paj7620 register value
+ * @brief run a register transaction through the bus scheduler
  *
  * @param dev device handle
- * @param addr register address
- * @param data the read data
+ * @param msgs i2c messages of the transaction
+ * @param num number of messages
+ * @param prio transaction priority
  *
  * @return operation result
  */
-static rt_err_t paj7620_read_reg(paj7620_device_t dev, rt_uint8_t addr, rt_uint8_t *data)
+static rt_err_t paj7620_transfer(paj7620_device_t dev, struct rt_i2c_msg msgs[], rt_uint32_t num,
+                                 paj7620_bus_prio_t prio)
 {
-    struct rt_i2c_msg msgs[2];
+    rt_int32_t deadline = RT_WAITING_FOREVER;
+    rt_err_t result = RT_ERROR;
+    rt_uint8_t i;
+
+    if (prio == PAJ7620_BUS_PRIO_URGENT)
+    {
+        deadline = rt_tick_from_millisecond(PAJ7620_POLL_DEADLINE_MS);
+    }
+
+    for (i = 0; i <= dev->retries; i++)
+    {
+        result = paj7620_bus_transfer(dev->bus, msgs, num, prio, deadline);
+
+        /* a missed deadline is not retried, the poll is simply skipped */
+        if (result != -RT_EIO)
+        {
+            break;
+        }
+    }
 
+    return result == RT_EOK ? RT_EOK : RT_ERROR;
+}
+
+/**
+ * @brief fill the messages of a register read
+ *
+ * @param msgs two messages to fill
+ * @param addr register address
+ * @param data the read data
+ * @param len number of registers to read
+ */
+static void paj7620_fill_read(struct rt_i2c_msg msgs[2], rt_uint8_t *addr, rt_uint8_t *data,
+                              rt_uint16_t len)
+{
     msgs[0].addr = PAJ7620_ID;
     msgs[0].flags = RT_I2C_WR;
-    msgs[0].buf = &addr;
+    msgs[0].buf = addr;
     msgs[0].len = 1;
 
     msgs[1].addr = PAJ7620_ID;
     msgs[1].flags = RT_I2C_RD;
     msgs[1].buf = data;
-    msgs[1].len = 1;
+    msgs[1].len = len;
+}
 
-    if (rt_i2c_transfer(dev->i2c, msgs, 2) == 0)
-    {
-        return RT_ERROR;
-    }
-    else
-    {
-        return RT_EOK;
-    }
+/**
+ * @brief read consecutive paj7620 registers in one burst
+ *
+ * @param dev device handle
+ * @param addr first register address
+ * @param data the read data
+ * @param len number of registers to read
+ * @param prio transaction priority
+ *
+ * @return operation result
+ */
+static rt_err_t paj7620_read_regs(paj7620_device_t dev, rt_uint8_t addr, rt_uint8_t *data,
+                                  rt_uint16_t len, paj7620_bus_prio_t prio)
+{
+    struct rt_i2c_msg msgs[2];
+
+    paj7620_fill_read(msgs, &addr, data, len);
+
+    return paj7620_transfer(dev, msgs, 2, prio);
+}
+
+/**
+ * @brief read paj7620 register value
+ *
+ * @param dev device handle
+ * @param addr register address
+ * @param data the read data
+ * @param prio transaction priority
+ *
+ * @return operation result
+ */
+static rt_err_t paj7620_read_reg(paj7620_device_t dev, rt_uint8_t addr, rt_uint8_t *data,
+                                 paj7620_bus_prio_t prio)
+{
+    return paj7620_read_regs(dev, addr, data, 1, prio);
 }
 
 /**
@@ -337,24 +422,40 @@ static rt_err_t paj7620_read_reg(paj7620_device_t dev, rt_uint8_t addr, rt_uint8
  * @param dev device handle
  * @param addr register address
  * @param data register value to be written to paj7620
+ * @param prio transaction priority
  *
  * @return operation result
  */
-static rt_err_t paj7620_write_reg(paj7620_device_t dev, rt_uint8_t addr, uint8_t data)
+static rt_err_t paj7620_write_reg(paj7620_device_t dev, rt_uint8_t addr, uint8_t data,
+                                  paj7620_bus_prio_t prio)
 {
+    struct rt_i2c_msg msg;
     rt_uint8_t buf[2];
 
     buf[0] = addr;
     buf[1] = data;
 
-    if (rt_i2c_master_send(dev->i2c, PAJ7620_ID, 0, buf, 2) == 2)
+    msg.addr = PAJ7620_ID;
+    msg.flags = RT_I2C_WR;
+    msg.buf = buf;
+    msg.len = 2;
+
+    if (paj7620_transfer(dev, &msg, 1, prio) != RT_EOK)
     {
-        return RT_EOK;
+        if (addr == PAJ_BANK_SEL)
+        {
+            dev->bank = PAJ7620_BANK_UNKNOWN;
+        }
+
+        return RT_ERROR;
     }
-    else
+
+    if (addr == PAJ_BANK_SEL)
     {
-        return RT_ERROR;
+        dev->bank = data;
     }
+
+    return RT_EOK;
 }
 
 /**
@@ -369,17 +470,22 @@ static rt_err_t paj7620_select_bank(paj7620_device_t dev, paj7620_bank_t bank)
 {
     RT_ASSERT((bank == PAJ7620_BANK0) || (bank == PAJ7620_BANK1));
 
+    if (dev->bank == bank)
+    {
+        return RT_EOK;
+    }
+
     switch (bank)
     {
     case PAJ7620_BANK0:
-        if (paj7620_write_reg(dev, PAJ_BANK_SEL, PAJ7620_BANK0) == RT_EOK)
+        if (paj7620_write_reg(dev, PAJ_BANK_SEL, PAJ7620_BANK0, PAJ7620_BUS_PRIO_NORMAL) == RT_EOK)
         {
             return RT_EOK;
         }
         break;
 
     case PAJ7620_BANK1:
-        if (paj7620_write_reg(dev, PAJ_BANK_SEL, PAJ7620_BANK1) == RT_EOK)
+        if (paj7620_write_reg(dev, PAJ_BANK_SEL, PAJ7620_BANK1, PAJ7620_BUS_PRIO_NORMAL) == RT_EOK)
         {
             return RT_EOK;
         }
@@ -393,157 +499,211 @@ static rt_err_t paj7620_select_bank(paj7620_device_t dev, paj7620_bank_t bank)
 }
 
 /**
- * @brief get gesture
+ * @brief decode the first interrupt flag register
+ *
+ * @param flag value of PAJ_GET_INT_FLAG1
+ *
+ * @return gesture, PAJ7620_GESTURE_NONE if the register holds no gesture
+ */
+static paj7620_gesture_t paj7620_decode_flag1(rt_uint8_t flag)
+{
+    switch (flag)
+    {
+    case GES_RIGHT_FLAG:
+        return PAJ7620_GESTURE_RIGHT;
+
+    case GES_LEFT_FLAG:
+        return PAJ7620_GESTURE_LEFT;
+
+    case GES_UP_FLAG:
+        return PAJ7620_GESTURE_UP;
+
+    case GES_DOWN_FLAG:
+        return PAJ7620_GESTURE_DOWN;
+
+    case GES_FORWARD_FLAG:
+        return PAJ7620_GESTURE_FORWARD;
+
+    case GES_BACKWARD_FLAG:
+        return PAJ7620_GESTURE_BACKWARD;
+
+    case GES_CLOCKWISE_FLAG:
+        return PAJ7620_GESTURE_CLOCKWISE;
+
+    case GES_COUNT_CLOCKWISE_FLAG:
+        return PAJ7620_GESTURE_ANTICLOCKWISE;
+
+    default:
+        return PAJ7620_GESTURE_NONE;
+    }
+}
+
+/**
+ * @brief check whether a gesture may still turn into forward/backward
+ *
+ * A hand moving towards or away from the sensor is first reported as one of
+ * the four directions, the confirmation read shortly after tells them apart.
+ *
+ * @param gest gesture decoded from the first flag read
+ *
+ * @return RT_TRUE if a confirmation read is needed
+ */
+static rt_bool_t paj7620_need_confirm(paj7620_gesture_t gest)
+{
+    return (gest == PAJ7620_GESTURE_UP) || (gest == PAJ7620_GESTURE_DOWN) ||
+           (gest == PAJ7620_GESTURE_LEFT) || (gest == PAJ7620_GESTURE_RIGHT);
+}
+
+/**
+ * @brief resolve a direction gesture with the confirmation read
+ *
+ * @param gest gesture decoded from the first flag read
+ * @param flag value of PAJ_GET_INT_FLAG1 read for confirmation
+ *
+ * @return resolved gesture
+ */
+static paj7620_gesture_t paj7620_confirm_gesture(paj7620_gesture_t gest, rt_uint8_t flag)
+{
+    if (flag == GES_FORWARD_FLAG)
+    {
+        return PAJ7620_GESTURE_FORWARD;
+    }
+    else if (flag == GES_BACKWARD_FLAG)
+    {
+        return PAJ7620_GESTURE_BACKWARD;
+    }
+
+    return gest;
+}
+
+/**
+ * @brief read and decode the pending gesture with its metadata
+ *
+ * The interrupt flags, gesture data, object and wave count registers are
+ * read in one transaction. A wave latched with another gesture is returned
+ * by the next call. The forward/backward confirmation is left to the
+ * caller.
  *
  * @param dev device handle
- * @param gest the gesture state read from register
+ * @param event the decoded gesture event
  *
  * @return operation result
  */
-rt_err_t paj7620_get_gesture(paj7620_device_t dev, paj7620_gesture_t *gest)
+static rt_err_t paj7620_read_event(paj7620_device_t dev, struct paj7620_gesture_event *event)
 {
-    rt_uint8_t gesture;
+    rt_uint8_t addr[4] = {PAJ_GET_INT_FLAG1, PAJ_GET_GESTURE_DATA,
+                          PAJ_GET_OBJECT_BRIGHTNESS, PAJ_GET_WAVE_COUNT};
+    rt_uint8_t flag[2], data, object[3], wave;
+    struct rt_i2c_msg msgs[8];
 
-    if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG1, &gesture) == RT_EOK)
+    paj7620_fill_read(&msgs[0], &addr[0], flag, sizeof(flag));
+    paj7620_fill_read(&msgs[2], &addr[1], &data, 1);
+    paj7620_fill_read(&msgs[4], &addr[2], object, sizeof(object));
+    paj7620_fill_read(&msgs[6], &addr[3], &wave, 1);
+
+    if (paj7620_transfer(dev, msgs, 8, PAJ7620_BUS_PRIO_URGENT) != RT_EOK)
     {
-        switch (gesture)
-        {
-        case GES_RIGHT_FLAG:
-            rt_thread_mdelay(1);
+        return RT_ERROR;
+    }
 
-            if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG1, &gesture) == RT_EOK)
-            {
-                if (gesture == GES_FORWARD_FLAG)
-                {
-                    *gest = PAJ7620_GESTURE_FORWARD;
-                }
-                else if (gesture == GES_BACKWARD_FLAG)
-                {
-                    *gest = PAJ7620_GESTURE_BACKWARD;
-                }
-                else
-                {
-                    *gest = PAJ7620_GESTURE_RIGHT;
-                }
-            }
-            else
-            {
-                return RT_ERROR;
-            }
-            break;
+    event->type = paj7620_decode_flag1(flag[0]);
 
-        case GES_LEFT_FLAG:
-            rt_thread_mdelay(1);
+    /* FLAG2 clears when read with FLAG1, a wave latched together with another
+     * gesture is kept and reported by the next read */
+    if (event->type == PAJ7620_GESTURE_NONE)
+    {
+        if (flag[1] == GES_WAVE_FLAG || dev->wave_latched)
+        {
+            event->type = PAJ7620_GESTURE_WAVE;
+        }
 
-            if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG1, &gesture) == RT_EOK)
-            {
-                if (gesture == GES_FORWARD_FLAG)
-                {
-                    *gest = PAJ7620_GESTURE_FORWARD;
-                }
-                else if (gesture == GES_BACKWARD_FLAG)
-                {
-                    *gest = PAJ7620_GESTURE_BACKWARD;
-                }
-                else
-                {
-                    *gest = PAJ7620_GESTURE_LEFT;
-                }
-            }
-            else
-            {
-                return RT_ERROR;
-            }
-            break;
+        dev->wave_latched = RT_FALSE;
+    }
+    else if (flag[1] == GES_WAVE_FLAG)
+    {
+        dev->wave_latched = RT_TRUE;
+    }
 
-        case GES_UP_FLAG:
-            rt_thread_mdelay(1);
+    event->timestamp = rt_tick_get();
+    event->speed = data;
+    event->brightness = object[0];
+    event->object_size = object[1] | ((object[2] & 0x0f) << 8);
+    event->wave_count = wave & 0x0f;
+    event->confidence = object[0] * 100 / 255;
 
-            if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG1, &gesture) == RT_EOK)
-            {
-                if (gesture == GES_FORWARD_FLAG)
-                {
-                    *gest = PAJ7620_GESTURE_FORWARD;
-                }
-                else if (gesture == GES_BACKWARD_FLAG)
-                {
-                    *gest = PAJ7620_GESTURE_BACKWARD;
-                }
-                else
-                {
-                    *gest = PAJ7620_GESTURE_UP;
-                }
-            }
-            else
-            {
-                return RT_ERROR;
-            }
-            break;
+    return RT_EOK;
+}
 
-        case GES_DOWN_FLAG:
-            rt_thread_mdelay(1);
+/**
+ * @brief get gesture event
+ *
+ * @param dev device handle
+ * @param event the gesture and its metadata read from register
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_get_gesture_event(paj7620_device_t dev, struct paj7620_gesture_event *event)
+{
+    rt_err_t result;
+    rt_uint8_t flag[2];
 
-            if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG1, &gesture) == RT_EOK)
-            {
-                if (gesture == GES_FORWARD_FLAG)
-                {
-                    *gest = PAJ7620_GESTURE_FORWARD;
-                }
-                else if (gesture == GES_BACKWARD_FLAG)
-                {
-                    *gest = PAJ7620_GESTURE_BACKWARD;
-                }
-                else
-                {
-                    *gest = PAJ7620_GESTURE_DOWN;
-                }
-            }
-            else
-            {
-                return RT_ERROR;
-            }
-            break;
+    RT_ASSERT(dev);
+    RT_ASSERT(event);
 
-        case GES_FORWARD_FLAG:
-            *gest = PAJ7620_GESTURE_FORWARD;
-            break;
+    rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
 
-        case GES_BACKWARD_FLAG:
-            *gest = PAJ7620_GESTURE_BACKWARD;
-            break;
+    result = paj7620_read_event(dev, event);
 
-        case GES_CLOCKWISE_FLAG:
-            *gest = PAJ7620_GESTURE_CLOCKWISE;
-            break;
+    if (result == RT_EOK && paj7620_need_confirm(event->type))
+    {
+        rt_thread_mdelay(PAJ7620_CONFIRM_DELAY_MS);
 
-        case GES_COUNT_CLOCKWISE_FLAG:
-            *gest = PAJ7620_GESTURE_ANTICLOCKWISE;
-            break;
+        result = paj7620_read_regs(dev, PAJ_GET_INT_FLAG1, flag, sizeof(flag), PAJ7620_BUS_PRIO_URGENT);
 
-        default:
-            if (paj7620_read_reg(dev, PAJ_GET_INT_FLAG2, &gesture) == RT_EOK)
-            {
-                if (gesture == GES_WAVE_FLAG)
-                {
-                    *gest = PAJ7620_GESTURE_WAVE;
-                }
-                else
-                {
-                    *gest = PAJ7620_GESTURE_NONE;
-                }
-            }
-            else
+        if (result == RT_EOK)
+        {
+            /* FLAG2 clears with FLAG1, a wave latched meanwhile is reported by the next read */
+            if (flag[1] == GES_WAVE_FLAG)
             {
-                return RT_ERROR;
+                dev->wave_latched = RT_TRUE;
             }
-            break;
+
+            event->type = paj7620_confirm_gesture(event->type, flag[0]);
         }
     }
-    else
+
+    if (result == RT_EOK && event->type != PAJ7620_GESTURE_NONE &&
+        !paj7620_filter_apply(&dev->filter, event))
+    {
+        event->type = PAJ7620_GESTURE_NONE;
+    }
+
+    rt_mutex_release(dev->lock);
+
+    return result;
+}
+
+/**
+ * @brief get gesture
+ *
+ * @param dev device handle
+ * @param gest the gesture state read from register
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_get_gesture(paj7620_device_t dev, paj7620_gesture_t *gest)
+{
+    struct paj7620_gesture_event event;
+
+    RT_ASSERT(gest);
+
+    if (paj7620_get_gesture_event(dev, &event) != RT_EOK)
     {
         return RT_ERROR;
     }
 
+    *gest = event.type;
+
     return RT_EOK;
 }
 
@@ -558,6 +718,9 @@ static rt_err_t paj7620_wakeup(paj7620_device_t dev)
 {
     rt_uint8_t data0, data1;
 
+    /* the first access only wakes the chip up, so both are really sent */
+    dev->bank = PAJ7620_BANK_UNKNOWN;
+
     if (paj7620_select_bank(dev, PAJ7620_BANK0) != RT_EOK)
     {
         return RT_ERROR;
@@ -565,17 +728,19 @@ static rt_err_t paj7620_wakeup(paj7620_device_t dev)
 
     rt_thread_mdelay(1);
 
+    dev->bank = PAJ7620_BANK_UNKNOWN;
+
     if (paj7620_select_bank(dev, PAJ7620_BANK0) != RT_EOK)
     {
         return RT_ERROR;
     }
 
-    if (paj7620_read_reg(dev, 0, &data0) != RT_EOK)
+    if (paj7620_read_reg(dev, 0, &data0, PAJ7620_BUS_PRIO_NORMAL) != RT_EOK)
     {
         return RT_ERROR;
     }
 
-    if (paj7620_read_reg(dev, 1, &data1) != RT_EOK)
+    if (paj7620_read_reg(dev, 1, &data1, PAJ7620_BUS_PRIO_NORMAL) != RT_EOK)
     {
         return RT_ERROR;
     }
@@ -595,95 +760,1261 @@ static rt_err_t paj7620_wakeup(paj7620_device_t dev)
 }
 
 /**
- * @brief import the default register setting to paj7620
- * 
- * @param dev device handle
- * 
- * @return operation result 
- */
-static rt_err_t paj7620_register_init(paj7620_device_t dev)
-{
-    rt_uint8_t i;
-
-    for (i = 0; i < sizeof(paj7620_init_regs) / sizeof(paj7620_init_regs[0]); i++)
-    {
-        if (paj7620_write_reg(dev, paj7620_init_regs[i][0], paj7620_init_regs[i][1]) != RT_EOK)
-        {
-            return RT_ERROR;
-        }
-    }
-
-    return RT_EOK;
-}
-
-/**
- * @brief initialize the paj7620
+ * @brief check for a paj7620 on a bus without initializing it
+ *
+ * Cheap enough to be repeated on buses without a sensor: the bus clock is
+ * left as it is, nothing is allocated and failures are only debug logged.
+ * The first access wakes a sleeping sensor up and isn't checked.
  *
  * @param i2c_bus_name the name of i2c device
- * @return paj7620 device handle
+ *
+ * @return RT_EOK if a paj7620 answered its part id, RT_ERROR if not
  */
-paj7620_device_t paj7620_init(const char *i2c_bus_name)
+rt_err_t paj7620_detect(const char *i2c_bus_name)
 {
-    paj7620_device_t dev;
+    struct rt_i2c_bus_device *i2c;
+    struct rt_i2c_msg msgs[2];
+    rt_uint8_t buf[2], addr = 0x00, id[2];
 
     RT_ASSERT(i2c_bus_name);
 
-    dev = rt_calloc(1, sizeof(struct paj7620_device));
+    i2c = rt_i2c_bus_device_find(i2c_bus_name);
 
-    if (dev == RT_NULL)
+    if (i2c == RT_NULL)
     {
-        LOG_E("Can't allocate memory for paj7620 device on '%s' ", i2c_bus_name);
-        return RT_NULL;
+        LOG_D("no i2c bus '%s'", i2c_bus_name);
+        return RT_ERROR;
     }
 
-    dev->i2c = rt_i2c_bus_device_find(i2c_bus_name);
-
-    if (dev->i2c == RT_NULL)
-    {
-        LOG_E("Can't find paj7620 device on '%s' ", i2c_bus_name);
-        rt_free(dev);
-        return RT_NULL;
-    }
+    buf[0] = PAJ_BANK_SEL;
+    buf[1] = PAJ7620_BANK0;
 
-    dev->lock = rt_mutex_create("mutex_paj7620", RT_IPC_FLAG_FIFO);
+    msgs[0].addr = PAJ7620_ID;
+    msgs[0].flags = RT_I2C_WR;
+    msgs[0].buf = buf;
+    msgs[0].len = 2;
 
-    if (dev->lock == RT_NULL)
-    {
-        LOG_E("Can't create mutex for paj7620 device on '%s' ", i2c_bus_name);
-        rt_free(dev);
-        return RT_NULL;
-    }
+    rt_i2c_transfer(i2c, msgs, 1);
+    rt_thread_mdelay(1);
 
-    if (paj7620_wakeup(dev) == RT_ERROR)
+    if (rt_i2c_transfer(i2c, msgs, 1) != 1)
     {
-        return RT_NULL;
+        LOG_D("no paj7620 answering on '%s'", i2c_bus_name);
+        return RT_ERROR;
     }
 
-    if (paj7620_register_init(dev) == RT_ERROR)
-    {
-        return RT_NULL;
-    }
+    paj7620_fill_read(msgs, &addr, id, 2);
 
-    if (paj7620_select_bank(dev, PAJ7620_BANK0) == RT_ERROR)
+    if (rt_i2c_transfer(i2c, msgs, 2) != 2 || id[0] != 0x20 || id[1] != 0x76)
     {
-        return RT_NULL;
+        LOG_D("no paj7620 id on '%s'", i2c_bus_name);
+        return RT_ERROR;
     }
 
-    LOG_I("paj7620 finished the initialization");
-
-    return dev;
+    return RT_EOK;
 }
 
 /**
- * @brief deinitialize the paj7620
+ * @brief change the i2c bus clock
  *
  * @param dev device handle
+ * @param clock bus clock in Hz
+ *
+ * @return operation result
  */
-void paj7620_deinit(paj7620_device_t dev)
+static rt_err_t paj7620_set_clock(paj7620_device_t dev, rt_uint32_t clock)
 {
-    RT_ASSERT(dev);
+#ifdef RT_I2C_DEV_CTRL_CLK
+    if (rt_i2c_control(dev->i2c, RT_I2C_DEV_CTRL_CLK, clock) == RT_EOK)
+    {
+        dev->clock = clock;
+        return RT_EOK;
+    }
+#endif
+
+    return RT_ERROR;
+}
+
+/**
+ * @brief bring up the bus at the fastest clock the sensor answers to
+ *
+ * Only done when PAJ7620_I2C_CLOCK is set, the BSP clock is kept otherwise.
+ * The bus is held during the whole negotiation so that no other device on
+ * it transfers at a clock that hasn't been verified yet. When the sensor
+ * doesn't answer, the bus goes back to PAJ7620_I2C_FALLBACK_CLOCK, which
+ * must be the clock the BSP configured.
+ *
+ * @param dev device handle
+ *
+ * @return operation result
+ */
+static rt_err_t paj7620_clock_setup(paj7620_device_t dev)
+{
+    rt_err_t result;
+
+    /* same order as a scheduled transfer: scheduler first, then the bus */
+    paj7620_bus_take(dev->bus, PAJ7620_BUS_PRIO_NORMAL, RT_WAITING_FOREVER);
+    rt_mutex_take(&dev->i2c->lock, RT_WAITING_FOREVER);
+
+    if (PAJ7620_I2C_CLOCK && paj7620_set_clock(dev, PAJ7620_I2C_CLOCK) == RT_EOK)
+    {
+        if (paj7620_wakeup(dev) == RT_EOK)
+        {
+            rt_mutex_release(&dev->i2c->lock);
+            paj7620_bus_release(dev->bus);
+            return RT_EOK;
+        }
+
+        LOG_W("paj7620 not responding at %d Hz, restoring %d Hz",
+              PAJ7620_I2C_CLOCK, PAJ7620_I2C_FALLBACK_CLOCK);
+
+        /* never leave the other devices on an unverified clock */
+        if (paj7620_set_clock(dev, PAJ7620_I2C_FALLBACK_CLOCK) != RT_EOK)
+        {
+            LOG_E("Can't restore the i2c bus clock, bus left at %d Hz", PAJ7620_I2C_CLOCK);
+            rt_mutex_release(&dev->i2c->lock);
+            paj7620_bus_release(dev->bus);
+            return RT_ERROR;
+        }
+    }
+
+    result = paj7620_wakeup(dev);
+
+    rt_mutex_release(&dev->i2c->lock);
+    paj7620_bus_release(dev->bus);
+
+    return result;
+}
+
+/**
+ * @brief import the default register setting to paj7620
+ *
+ * The table is written in chunks of PAJ7620_INIT_CHUNK registers, giving the
+ * bus to more urgent transactions between two chunks.
+ *
+ * @param dev device handle
+ *
+ * @return operation result
+ */
+static rt_err_t paj7620_register_init(paj7620_device_t dev)
+{
+    rt_err_t result = RT_EOK;
+    rt_uint8_t i;
+
+    paj7620_bus_take(dev->bus, PAJ7620_BUS_PRIO_BULK, RT_WAITING_FOREVER);
+
+    for (i = 0; i < sizeof(paj7620_init_regs) / sizeof(paj7620_init_regs[0]); i++)
+    {
+        if (i && (i % PAJ7620_INIT_CHUNK) == 0)
+        {
+            paj7620_bus_yield(dev->bus, PAJ7620_BUS_PRIO_BULK);
+        }
+
+        if (paj7620_write_reg(dev, paj7620_init_regs[i][0], paj7620_init_regs[i][1],
+                              PAJ7620_BUS_PRIO_BULK) != RT_EOK)
+        {
+            result = RT_ERROR;
+            break;
+        }
+    }
+
+    paj7620_bus_release(dev->bus);
+
+    return result;
+}
+
+/**
+ * @brief read consecutive registers of a bank
+ *
+ * @param dev device handle
+ * @param bank register bank
+ * @param addr first register address
+ * @param data the read data
+ * @param len number of registers to read
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_read_bank_regs(paj7620_device_t dev, rt_uint8_t bank, rt_uint8_t addr,
+                                rt_uint8_t *data, rt_uint16_t len)
+{
+    rt_err_t result;
+
+    RT_ASSERT(dev);
+    RT_ASSERT(data);
+
+    if (bank > PAJ7620_BANK1)
+    {
+        return -RT_EINVAL;
+    }
+
+    rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
+
+    result = paj7620_select_bank(dev, (paj7620_bank_t)bank);
+
+    if (result == RT_EOK)
+    {
+        result = paj7620_read_regs(dev, addr, data, len, PAJ7620_BUS_PRIO_NORMAL);
+    }
+
+    /* the gesture reads expect bank 0 */
+    if (paj7620_select_bank(dev, PAJ7620_BANK0) != RT_EOK)
+    {
+        result = RT_ERROR;
+    }
+
+    rt_mutex_release(dev->lock);
+
+    return result;
+}
+
+/**
+ * @brief keep a register override for the next reloads
+ *
+ * @param dev device handle
+ * @param bank register bank
+ * @param addr register address
+ * @param data register value
+ *
+ * @return operation result, -RT_EFULL if there is no room left
+ */
+static rt_err_t paj7620_keep_override(paj7620_device_t dev, rt_uint8_t bank, rt_uint8_t addr,
+                                      rt_uint8_t data)
+{
+    rt_uint8_t i;
+
+    for (i = 0; i < dev->override_count; i++)
+    {
+        if (dev->overrides[i].bank == bank && dev->overrides[i].addr == addr)
+        {
+            dev->overrides[i].value = data;
+            return RT_EOK;
+        }
+    }
+
+    if (dev->override_count >= PAJ7620_OVERRIDES)
+    {
+        LOG_W("paj7620 overrides full, bank%d 0x%02x is lost on reload", bank, addr);
+        return -RT_EFULL;
+    }
+
+    dev->overrides[dev->override_count].bank = bank;
+    dev->overrides[dev->override_count].addr = addr;
+    dev->overrides[dev->override_count].value = data;
+    dev->override_count++;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief write the register overrides again after the init table
+ *
+ * @param dev device handle
+ *
+ * @return operation result
+ */
+static rt_err_t paj7620_replay_overrides(paj7620_device_t dev)
+{
+    struct paj7620_override *override;
+    rt_uint8_t i;
+
+    for (i = 0; i < dev->override_count; i++)
+    {
+        override = &dev->overrides[i];
+
+        if (paj7620_select_bank(dev, (paj7620_bank_t)override->bank) != RT_EOK ||
+            paj7620_write_reg(dev, override->addr, override->value, PAJ7620_BUS_PRIO_NORMAL) != RT_EOK)
+        {
+            return RT_ERROR;
+        }
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * @brief value a register of the init table is expected to hold
+ *
+ * @param dev device handle
+ * @param bank register bank of the table entry
+ * @param index index in the init table
+ *
+ * @return the override of the register, the table value without one
+ */
+static rt_uint8_t paj7620_expected_reg(paj7620_device_t dev, rt_uint8_t bank, rt_size_t index)
+{
+    rt_uint8_t i;
+
+    for (i = 0; i < dev->override_count; i++)
+    {
+        if (dev->overrides[i].bank == bank && dev->overrides[i].addr == paj7620_init_regs[index][0])
+        {
+            return dev->overrides[i].value;
+        }
+    }
+
+    return paj7620_init_regs[index][1];
+}
+
+/**
+ * @brief write a register of a bank
+ *
+ * The value is kept as an override and written again whenever the sensor
+ * is reinitialized, until paj7620_clear_overrides().
+ *
+ * @param dev device handle
+ * @param bank register bank
+ * @param addr register address, not the bank select register
+ * @param data register value
+ *
+ * @return operation result, -RT_EFULL if written but not kept for the reloads
+ */
+rt_err_t paj7620_write_bank_reg(paj7620_device_t dev, rt_uint8_t bank, rt_uint8_t addr,
+                                rt_uint8_t data)
+{
+    rt_err_t result;
+
+    RT_ASSERT(dev);
+
+    if (bank > PAJ7620_BANK1 || addr == PAJ_BANK_SEL)
+    {
+        return -RT_EINVAL;
+    }
+
+    rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
+
+    result = paj7620_select_bank(dev, (paj7620_bank_t)bank);
+
+    if (result == RT_EOK)
+    {
+        result = paj7620_write_reg(dev, addr, data, PAJ7620_BUS_PRIO_NORMAL);
+    }
+
+    if (paj7620_select_bank(dev, PAJ7620_BANK0) != RT_EOK)
+    {
+        result = RT_ERROR;
+    }
+
+    if (result == RT_EOK)
+    {
+        result = paj7620_keep_override(dev, bank, addr, data);
+    }
+
+    rt_mutex_release(dev->lock);
+
+    return result;
+}
+
+/**
+ * @brief forget the register overrides, the next reload writes the init table only
+ *
+ * @param dev device handle
+ */
+void paj7620_clear_overrides(paj7620_device_t dev)
+{
+    RT_ASSERT(dev);
+
+    rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
+    dev->override_count = 0;
+    rt_mutex_release(dev->lock);
+}
+
+/**
+ * @brief set the gesture report rate
+ *
+ * Written as register overrides, the rate is kept across reloads.
+ *
+ * @param dev device handle
+ * @param rate PAJ7620_RATE_NORMAL (120 fps) or PAJ7620_RATE_GAMING (240 fps)
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_set_rate(paj7620_device_t dev, paj7620_rate_t rate)
+{
+    rt_uint8_t idle;
+
+    RT_ASSERT(dev);
+
+    idle = (rate == PAJ7620_RATE_GAMING) ? PAJ7620_GAMING_IDLE_TIME : PAJ7620_NORMAL_IDLE_TIME;
+
+    if (paj7620_write_bank_reg(dev, PAJ7620_BANK1, PAJ_SET_IDLE_TIME_0, idle) != RT_EOK ||
+        paj7620_write_bank_reg(dev, PAJ7620_BANK1, PAJ_SET_IDLE_TIME_1, 0) != RT_EOK)
+    {
+        return RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * @brief read the object currently seen by the sensor
+ *
+ * @param dev device handle
+ * @param brightness the object brightness, higher when closer
+ * @param size the object size in pixels, may be RT_NULL
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_get_object(paj7620_device_t dev, rt_uint8_t *brightness, rt_uint16_t *size)
+{
+    rt_uint8_t object[3];
+
+    RT_ASSERT(brightness);
+
+    if (paj7620_read_bank_regs(dev, PAJ7620_BANK0, PAJ_GET_OBJECT_BRIGHTNESS, object,
+                               sizeof(object)) != RT_EOK)
+    {
+        return RT_ERROR;
+    }
+
+    *brightness = object[0];
+
+    if (size != RT_NULL)
+    {
+        *size = object[1] | ((object[2] & 0x0f) << 8);
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * @brief wake the sensor up and write the default register setting again
+ *
+ * The register overrides are written again after the init table.
+ *
+ * @param dev device handle
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_reload(paj7620_device_t dev)
+{
+    rt_err_t result;
+
+    RT_ASSERT(dev);
+
+    rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
+
+    /* a sensor that lost power only answers after the wakeup sequence */
+    result = paj7620_wakeup(dev);
+
+    if (result == RT_EOK)
+    {
+        result = paj7620_register_init(dev);
+    }
+
+    if (result == RT_EOK)
+    {
+        result = paj7620_replay_overrides(dev);
+    }
+
+    if (result == RT_EOK)
+    {
+        result = paj7620_select_bank(dev, PAJ7620_BANK0);
+    }
+
+    rt_mutex_release(dev->lock);
+
+    return result;
+}
+
+/**
+ * @brief update a crc16 (CCITT) with new bytes
+ *
+ * @param crc current crc
+ * @param data new bytes
+ * @param len number of bytes
+ *
+ * @return updated crc
+ */
+static rt_uint16_t paj7620_crc16(rt_uint16_t crc, const rt_uint8_t *data, rt_size_t len)
+{
+    rt_uint8_t bit;
+
+    while (len--)
+    {
+        crc ^= (rt_uint16_t)(*data++) << 8;
+
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief read back a run of consecutive registers of the init table
+ *
+ * @param dev device handle
+ * @param bank register bank of the run
+ * @param start index of the first register in paj7620_init_regs
+ * @param len number of registers in the run
+ * @param crc crc of all the registers read so far, updated
+ *
+ * @return RT_EOK if the run matches the table, RT_ERROR if not, -RT_EIO on bus error
+ */
+static rt_err_t paj7620_verify_run(paj7620_device_t dev, rt_uint8_t bank, rt_size_t start,
+                                   rt_size_t len, rt_uint16_t *crc)
+{
+    rt_uint8_t buf[PAJ7620_VERIFY_BURST], expected;
+    rt_uint16_t read_crc = 0xffff, table_crc = 0xffff;
+    rt_size_t i, n;
+
+    for (i = 0; i < len; i += n)
+    {
+        n = len - i;
+        if (n > PAJ7620_VERIFY_BURST)
+        {
+            n = PAJ7620_VERIFY_BURST;
+        }
+
+        if (paj7620_read_regs(dev, paj7620_init_regs[start + i][0], buf, n,
+                              PAJ7620_BUS_PRIO_NORMAL) != RT_EOK)
+        {
+            return -RT_EIO;
+        }
+
+        read_crc = paj7620_crc16(read_crc, buf, n);
+        *crc = paj7620_crc16(*crc, buf, n);
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        expected = paj7620_expected_reg(dev, bank, start + i);
+        table_crc = paj7620_crc16(table_crc, &expected, 1);
+    }
+
+    return (read_crc == table_crc) ? RT_EOK : RT_ERROR;
+}
+
+/**
+ * @brief verify the configuration written by paj7620_register_init
+ *
+ * Every run of consecutive registers of the init table is read back in
+ * bursts of PAJ7620_VERIFY_BURST and checked against the table by crc, so
+ * the whole table costs about twenty reads. Mismatching runs are logged by
+ * bank and address.
+ *
+ * @param dev device handle
+ * @param crc crc of all the registers read back, may be RT_NULL
+ *
+ * @return RT_EOK if the configuration matches, RT_ERROR if not, -RT_EIO on bus error
+ */
+rt_err_t paj7620_verify(paj7620_device_t dev, rt_uint16_t *crc)
+{
+    rt_size_t count = sizeof(paj7620_init_regs) / sizeof(paj7620_init_regs[0]);
+    rt_uint16_t read_crc = 0xffff;
+    rt_uint8_t bank = PAJ7620_BANK0;
+    rt_err_t result = RT_EOK, run;
+    rt_size_t i, start;
+
+    RT_ASSERT(dev);
+
+    rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
+
+    for (i = 0; i < count && result != -RT_EIO; )
+    {
+        /* bank switches of the table are replayed, not verified */
+        if (paj7620_init_regs[i][0] == PAJ_BANK_SEL)
+        {
+            bank = paj7620_init_regs[i][1];
+
+            if (paj7620_select_bank(dev, (paj7620_bank_t)bank) != RT_EOK)
+            {
+                result = -RT_EIO;
+            }
+
+            i++;
+            continue;
+        }
+
+        for (start = i++; i < count; i++)
+        {
+            if (paj7620_init_regs[i][0] == PAJ_BANK_SEL ||
+                paj7620_init_regs[i][0] != paj7620_init_regs[i - 1][0] + 1)
+            {
+                break;
+            }
+        }
+
+        run = paj7620_verify_run(dev, bank, start, i - start, &read_crc);
+
+        if (run == RT_ERROR)
+        {
+            LOG_W("paj7620 bank%d 0x%02x-0x%02x doesn't match the init table", bank,
+                  paj7620_init_regs[start][0], paj7620_init_regs[i - 1][0]);
+
+            if (result == RT_EOK)
+            {
+                result = RT_ERROR;
+            }
+        }
+        else if (run == -RT_EIO)
+        {
+            result = -RT_EIO;
+        }
+    }
+
+    if (bank != PAJ7620_BANK0 && paj7620_select_bank(dev, PAJ7620_BANK0) != RT_EOK)
+    {
+        result = -RT_EIO;
+    }
+
+    rt_mutex_release(dev->lock);
+
+    if (crc != RT_NULL)
+    {
+        *crc = read_crc;
+    }
+
+    return result;
+}
+
+/**< workqueue shared by the sensors started without one */
+static struct rt_workqueue *paj7620_wq = RT_NULL;
+
+/**
+ * @brief put a gesture event into the fifo
+ *
+ * @param dev device handle
+ * @param event gesture event
+ *
+ * @return RT_TRUE if queued, RT_FALSE if the fifo is full
+ */
+static rt_bool_t paj7620_fifo_put(paj7620_device_t dev, const struct paj7620_gesture_event *event)
+{
+    rt_base_t level;
+    rt_bool_t full;
+
+    level = rt_hw_interrupt_disable();
+    full = (dev->event_count >= PAJ7620_EVENT_FIFO_SIZE);
+    if (!full)
+    {
+        dev->events[(dev->event_head + dev->event_count) % PAJ7620_EVENT_FIFO_SIZE] = *event;
+        dev->event_count++;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (full)
+    {
+        LOG_W("paj7620 event fifo full, gesture dropped");
+        return RT_FALSE;
+    }
+
+    rt_sem_release(&dev->event_sem);
+
+    return RT_TRUE;
+}
+
+/**
+ * @brief filter a gesture event and queue it for the application
+ *
+ * @param dev device handle
+ * @param event detected gesture event
+ */
+static void paj7620_push_event(paj7620_device_t dev, struct paj7620_gesture_event *event)
+{
+    rt_bool_t accepted;
+
+    rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
+    accepted = paj7620_filter_apply(&dev->filter, event);
+    rt_mutex_release(dev->lock);
+
+    if (accepted && paj7620_fifo_put(dev, event) && dev->indicate)
+    {
+        dev->indicate(dev);
+    }
+}
+
+/**
+ * @brief reinitialize the sensor from the engine
+ *
+ * @param dev device handle
+ */
+static void paj7620_reinit(paj7620_device_t dev)
+{
+    dev->errors = 0;
+
+    if (paj7620_reload(dev) == RT_EOK)
+    {
+        LOG_I("paj7620 recovered");
+    }
+}
+
+/**
+ * @brief count a bus error and reinitialize the sensor when it stops answering
+ *
+ * @param dev device handle
+ */
+static void paj7620_recover(paj7620_device_t dev)
+{
+    if (++dev->errors >= PAJ7620_RECOVERY_ERRORS)
+    {
+        LOG_W("paj7620 not responding, reinitializing");
+        paj7620_reinit(dev);
+    }
+}
+
+/**
+ * @brief queue the flag read
+ *
+ * The workqueue refuses to queue a running work item without delay, the read
+ * is then queued a tick later so that an INT edge seen meanwhile isn't lost.
+ * Safe to call from the INT interrupt.
+ *
+ * @param dev device handle
+ * @param ticks delay of the read
+ *
+ * @return operation result
+ */
+static rt_err_t paj7620_queue_poll(paj7620_device_t dev, rt_tick_t ticks)
+{
+    rt_err_t result;
+
+    result = rt_workqueue_submit_work(dev->wq, &dev->poll_work, ticks);
+
+    if (result == -RT_EBUSY && ticks == 0)
+    {
+        result = rt_workqueue_submit_work(dev->wq, &dev->poll_work, 1);
+    }
+
+    return result;
+}
+
+/**
+ * @brief schedule the next flag read
+ *
+ * With an INT pin the next falling edge triggers the read, unless the flags
+ * couldn't be read and the line is still asserted. A latched wave raises no
+ * new edge and is read right away.
+ *
+ * @param dev device handle
+ * @param failed whether the last read failed
+ */
+static void paj7620_schedule_poll(paj7620_device_t dev, rt_bool_t failed)
+{
+    rt_err_t result = RT_EOK;
+
+    if (!dev->running)
+    {
+        return;
+    }
+
+    if (dev->wave_latched && !failed)
+    {
+        result = paj7620_queue_poll(dev, 0);
+    }
+    else if (dev->int_pin < 0 || failed)
+    {
+        result = paj7620_queue_poll(dev, rt_tick_from_millisecond(PAJ7620_POLL_PERIOD_MS));
+    }
+
+    if (result != RT_EOK)
+    {
+        LOG_W("paj7620 flag read not queued (%d)", (int)result);
+    }
+}
+
+/**
+ * @brief work item reading the gesture flags
+ *
+ * @param work work item
+ * @param work_data device handle
+ */
+static void paj7620_poll_work(struct rt_work *work, void *work_data)
+{
+    paj7620_device_t dev = (paj7620_device_t)work_data;
+    struct paj7620_gesture_event event;
+    rt_err_t result;
+
+    /* the pending confirmation read clears the flags itself */
+    if (dev->pending.type != PAJ7620_GESTURE_NONE)
+    {
+        return;
+    }
+
+    /* a latched wave is read here rather than by queuing this running item again */
+    do
+    {
+        rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
+        result = paj7620_read_event(dev, &event);
+        rt_mutex_release(dev->lock);
+
+        if (result != RT_EOK)
+        {
+            paj7620_recover(dev);
+            paj7620_schedule_poll(dev, RT_TRUE);
+            return;
+        }
+
+        dev->errors = 0;
+
+        if (paj7620_need_confirm(event.type))
+        {
+            dev->pending = event;
+
+            if (rt_workqueue_submit_work(dev->wq, &dev->confirm_work,
+                                         rt_tick_from_millisecond(PAJ7620_CONFIRM_DELAY_MS)) != RT_EOK)
+            {
+                LOG_W("paj7620 confirmation not queued");
+                dev->pending.type = PAJ7620_GESTURE_NONE;
+                paj7620_schedule_poll(dev, RT_TRUE);
+            }
+
+            return;
+        }
+
+        if (event.type != PAJ7620_GESTURE_NONE)
+        {
+            paj7620_push_event(dev, &event);
+        }
+    } while (dev->wave_latched && dev->running);
+
+    paj7620_schedule_poll(dev, RT_FALSE);
+}
+
+/**
+ * @brief work item telling forward/backward from a direction gesture
+ *
+ * @param work work item
+ * @param work_data device handle
+ */
+static void paj7620_confirm_work(struct rt_work *work, void *work_data)
+{
+    paj7620_device_t dev = (paj7620_device_t)work_data;
+    struct paj7620_gesture_event event = dev->pending;
+    rt_uint8_t flag[2];
+    rt_err_t result;
+
+    /* both flags are read to release the INT line, the polls of the delay were skipped */
+    rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
+    result = paj7620_read_regs(dev, PAJ_GET_INT_FLAG1, flag, sizeof(flag), PAJ7620_BUS_PRIO_URGENT);
+    rt_mutex_release(dev->lock);
+
+    dev->pending.type = PAJ7620_GESTURE_NONE;
+
+    if (result == RT_EOK)
+    {
+        dev->errors = 0;
+
+        if (flag[1] == GES_WAVE_FLAG)
+        {
+            dev->wave_latched = RT_TRUE;
+        }
+
+        event.type = paj7620_confirm_gesture(event.type, flag[0]);
+        paj7620_push_event(dev, &event);
+    }
+    else
+    {
+        paj7620_recover(dev);
+    }
+
+    paj7620_schedule_poll(dev, result != RT_EOK);
+}
+
+/**
+ * @brief work item checking the configuration every PAJ7620_HEALTH_CHECK_MS
+ *
+ * @param work work item
+ * @param work_data device handle
+ */
+static void paj7620_health_work(struct rt_work *work, void *work_data)
+{
+    paj7620_device_t dev = (paj7620_device_t)work_data;
+    rt_err_t result;
+
+    result = paj7620_verify(dev, RT_NULL);
+
+    if (result == RT_ERROR)
+    {
+        LOG_W("paj7620 configuration lost, reinitializing");
+        paj7620_reinit(dev);
+    }
+    else if (result != RT_EOK)
+    {
+        /* a bus error is no proof of a lost configuration */
+        paj7620_recover(dev);
+    }
+
+    if (dev->running)
+    {
+        rt_workqueue_submit_work(dev->wq, &dev->health_work,
+                                 rt_tick_from_millisecond(PAJ7620_HEALTH_CHECK_MS));
+    }
+}
+
+/**
+ * @brief arm the INT pin as wake source before the MCU enters deep sleep
+ *
+ * The sensor keeps detecting in its own low-power idle state. The flags
+ * latched so far are read to release the INT line, so that the next gesture
+ * raises a new edge and wakes the MCU.
+ *
+ * @param dev device handle
+ *
+ * @return operation result, -RT_EINVAL if the engine isn't running on an INT pin
+ */
+rt_err_t paj7620_sleep(paj7620_device_t dev)
+{
+    struct paj7620_gesture_event event;
+    rt_err_t result;
+
+    RT_ASSERT(dev);
+
+    if (!dev->running || dev->int_pin < 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    rt_workqueue_cancel_work_sync(dev->wq, &dev->poll_work);
+    rt_workqueue_cancel_work_sync(dev->wq, &dev->confirm_work);
+    rt_workqueue_cancel_work_sync(dev->wq, &dev->health_work);
+    dev->pending.type = PAJ7620_GESTURE_NONE;
+
+    /* a latched wave would be left behind until the next wake */
+    do
+    {
+        rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
+        result = paj7620_read_event(dev, &event);
+        rt_mutex_release(dev->lock);
+
+        if (result != RT_EOK)
+        {
+            paj7620_schedule_poll(dev, RT_TRUE);
+            return RT_ERROR;
+        }
+
+        if (event.type != PAJ7620_GESTURE_NONE)
+        {
+            paj7620_push_event(dev, &event);
+        }
+    } while (dev->wave_latched);
+
+    dev->sleeping = RT_TRUE;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief report the wake up of the MCU from deep sleep
+ *
+ * Called from the INT interrupt when the device sleeps. The bus isn't
+ * touched here: the flag read is queued ahead of the other work items and
+ * is the first transaction once the threads run again, through the normal
+ * locks and with the confirmation, filter and indicate callback of any
+ * other gesture. BSPs that restore the i2c controller in a resume hook may
+ * call it from there as well, a second call is ignored.
+ *
+ * @param dev device handle
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_wake_event(paj7620_device_t dev)
+{
+    RT_ASSERT(dev);
+
+    if (!dev->sleeping)
+    {
+        return RT_EOK;
+    }
+
+    dev->sleeping = RT_FALSE;
+
+    rt_workqueue_urgent_work(dev->wq, &dev->poll_work);
+
+    if (PAJ7620_HEALTH_CHECK_MS > 0)
+    {
+        rt_workqueue_submit_work(dev->wq, &dev->health_work,
+                                 rt_tick_from_millisecond(PAJ7620_HEALTH_CHECK_MS));
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * @brief INT pin interrupt handler
+ *
+ * @param args device handle
+ */
+static void paj7620_int_isr(void *args)
+{
+    paj7620_device_t dev = (paj7620_device_t)args;
+
+    if (dev->sleeping)
+    {
+        paj7620_wake_event(dev);
+        return;
+    }
+
+    paj7620_queue_poll(dev, 0);
+}
+
+/**
+ * @brief start the gesture detection engine
+ *
+ * All the driver activity runs as work items, detected gestures are queued
+ * and read with paj7620_wait_event().
+ *
+ * @param dev device handle
+ * @param wq workqueue to run on, RT_NULL for the one shared by the driver
+ * @param int_pin pin wired to the INT line, -1 to poll every PAJ7620_POLL_PERIOD_MS
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_start(paj7620_device_t dev, struct rt_workqueue *wq, rt_base_t int_pin)
+{
+    RT_ASSERT(dev);
+
+    if (dev->running)
+    {
+        return -RT_EBUSY;
+    }
+
+    if (wq == RT_NULL)
+    {
+        if (paj7620_wq == RT_NULL)
+        {
+            paj7620_wq = rt_workqueue_create("paj7620", PAJ7620_WORKQUEUE_STACK,
+                                             PAJ7620_WORKQUEUE_PRIORITY);
+        }
+
+        if (paj7620_wq == RT_NULL)
+        {
+            LOG_E("Can't create workqueue for paj7620");
+            return -RT_ENOMEM;
+        }
+
+        wq = paj7620_wq;
+    }
+
+    dev->wq = wq;
+    dev->int_pin = int_pin;
+    dev->pending.type = PAJ7620_GESTURE_NONE;
+    dev->errors = 0;
+    rt_work_init(&dev->poll_work, paj7620_poll_work, dev);
+    rt_work_init(&dev->confirm_work, paj7620_confirm_work, dev);
+    rt_work_init(&dev->health_work, paj7620_health_work, dev);
+    dev->running = RT_TRUE;
+
+    if (int_pin >= 0)
+    {
+        rt_pin_mode(int_pin, PIN_MODE_INPUT_PULLUP);
+
+        if (rt_pin_attach_irq(int_pin, PIN_IRQ_MODE_FALLING, paj7620_int_isr, dev) != RT_EOK)
+        {
+            LOG_E("Can't attach paj7620 interrupt on pin %d", (int)int_pin);
+            dev->running = RT_FALSE;
+            return RT_ERROR;
+        }
+
+        rt_pin_irq_enable(int_pin, PIN_IRQ_ENABLE);
+    }
+
+    /* the first read also clears the flags latched before the pin was armed */
+    paj7620_queue_poll(dev, 0);
+
+    if (PAJ7620_HEALTH_CHECK_MS > 0)
+    {
+        rt_workqueue_submit_work(wq, &dev->health_work,
+                                 rt_tick_from_millisecond(PAJ7620_HEALTH_CHECK_MS));
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * @brief stop the gesture detection engine
+ *
+ * Must not be called from the workqueue the engine runs on.
+ *
+ * @param dev device handle
+ */
+void paj7620_stop(paj7620_device_t dev)
+{
+    RT_ASSERT(dev);
+
+    if (!dev->running)
+    {
+        return;
+    }
+
+    dev->running = RT_FALSE;
+    dev->sleeping = RT_FALSE;
+
+    if (dev->int_pin >= 0)
+    {
+        rt_pin_irq_enable(dev->int_pin, PIN_IRQ_DISABLE);
+        rt_pin_detach_irq(dev->int_pin);
+    }
+
+    /* the poll work may still submit the confirmation, cancel it last */
+    rt_workqueue_cancel_work_sync(dev->wq, &dev->poll_work);
+    rt_workqueue_cancel_work_sync(dev->wq, &dev->confirm_work);
+    rt_workqueue_cancel_work_sync(dev->wq, &dev->health_work);
+
+    dev->pending.type = PAJ7620_GESTURE_NONE;
+}
+
+/**
+ * @brief set the callback invoked when a gesture event is queued
+ *
+ * The callback runs on the engine workqueue.
+ *
+ * @param dev device handle
+ * @param indicate callback, RT_NULL to remove it
+ */
+void paj7620_set_indicate(paj7620_device_t dev, void (*indicate)(paj7620_device_t dev))
+{
+    RT_ASSERT(dev);
+
+    dev->indicate = indicate;
+}
+
+/**
+ * @brief select the filter stages run on every gesture event
+ *
+ * @param dev device handle
+ * @param config filter configuration, RT_NULL to let every gesture through
+ */
+void paj7620_set_filter(paj7620_device_t dev, const struct paj7620_filter_config *config)
+{
+    RT_ASSERT(dev);
+
+    rt_mutex_take(dev->lock, RT_WAITING_FOREVER);
+    paj7620_filter_init(&dev->filter, config);
+    rt_mutex_release(dev->lock);
+}
+
+/**
+ * @brief take the oldest gesture event queued by the engine
+ *
+ * @param dev device handle
+ * @param event the gesture event
+ * @param timeout ticks to wait for an event
+ *
+ * @return operation result, -RT_ETIMEOUT if no gesture was detected in time
+ */
+rt_err_t paj7620_wait_event(paj7620_device_t dev, struct paj7620_gesture_event *event, rt_int32_t timeout)
+{
+    rt_base_t level;
+
+    RT_ASSERT(dev);
+    RT_ASSERT(event);
+
+    if (rt_sem_take(&dev->event_sem, timeout) != RT_EOK)
+    {
+        return -RT_ETIMEOUT;
+    }
+
+    level = rt_hw_interrupt_disable();
+    *event = dev->events[dev->event_head];
+    dev->event_head = (dev->event_head + 1) % PAJ7620_EVENT_FIFO_SIZE;
+    dev->event_count--;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief initialize the paj7620
+ *
+ * @param i2c_bus_name the name of i2c device
+ * @return paj7620 device handle
+ */
+paj7620_device_t paj7620_init(const char *i2c_bus_name)
+{
+    paj7620_device_t dev;
+
+    RT_ASSERT(i2c_bus_name);
+
+    dev = rt_calloc(1, sizeof(struct paj7620_device));
+
+    if (dev == RT_NULL)
+    {
+        LOG_E("Can't allocate memory for paj7620 device on '%s' ", i2c_bus_name);
+        return RT_NULL;
+    }
+
+    dev->i2c = rt_i2c_bus_device_find(i2c_bus_name);
+
+    if (dev->i2c == RT_NULL)
+    {
+        LOG_E("Can't find paj7620 device on '%s' ", i2c_bus_name);
+        rt_free(dev);
+        return RT_NULL;
+    }
+
+    dev->retries = PAJ7620_I2C_RETRIES;
+    dev->bank = PAJ7620_BANK_UNKNOWN;
+    dev->int_pin = -1;
+    dev->pending.type = PAJ7620_GESTURE_NONE;
+    paj7620_filter_init(&dev->filter, RT_NULL);
+
+    dev->bus = paj7620_bus_attach(dev->i2c);
+
+    if (dev->bus == RT_NULL)
+    {
+        rt_free(dev);
+        return RT_NULL;
+    }
+
+    dev->lock = rt_mutex_create("mutex_paj7620", RT_IPC_FLAG_FIFO);
+
+    if (dev->lock == RT_NULL)
+    {
+        LOG_E("Can't create mutex for paj7620 device on '%s' ", i2c_bus_name);
+        paj7620_bus_detach(dev->bus);
+        rt_free(dev);
+        return RT_NULL;
+    }
+
+    rt_sem_init(&dev->event_sem, "paj_evt", 0, RT_IPC_FLAG_FIFO);
+
+    if (paj7620_clock_setup(dev) != RT_EOK ||
+        paj7620_register_init(dev) != RT_EOK ||
+        paj7620_select_bank(dev, PAJ7620_BANK0) != RT_EOK)
+    {
+        LOG_E("paj7620 on '%s' failed to initialize", i2c_bus_name);
+        paj7620_deinit(dev);
+        return RT_NULL;
+    }
+
+#ifdef PAJ7620_USING_INIT_VERIFY
+    if (paj7620_verify(dev, RT_NULL) != RT_EOK)
+    {
+        LOG_E("paj7620 configuration readback failed");
+        paj7620_deinit(dev);
+        return RT_NULL;
+    }
+#endif
+
+    if (dev->clock)
+    {
+        LOG_I("paj7620 finished the initialization at %d Hz", dev->clock);
+    }
+    else
+    {
+        LOG_I("paj7620 finished the initialization at the BSP clock");
+    }
+
+    return dev;
+}
+
+/**
+ * @brief deinitialize the paj7620
+ *
+ * @param dev device handle
+ */
+void paj7620_deinit(paj7620_device_t dev)
+{
+    RT_ASSERT(dev);
+
+    paj7620_stop(dev);
 
+    rt_sem_detach(&dev->event_sem);
     rt_mutex_delete(dev->lock);
+    paj7620_bus_detach(dev->bus);
     rt_free(dev);
 }
 
@@ -5,6 +5,19 @@
 // Change Logs:
 // Date                 Author      Note
 // 2020/07/05           Cheney      First draft version
+// 2026/10/19           agent       Add i2c bus clock and retry options.
+// 2026/10/19           agent       Add bus scheduler options.
+// 2026/10/19           agent       Add the workqueue driven gesture engine.
+// 2026/10/19           agent       Add the gesture event metadata.
+// 2026/10/19           agent       Add the gesture filter pipeline.
+// 2026/10/19           agent       Add the configuration readback verification.
+// 2026/10/19           agent       Add wake-on-gesture.
+// 2026/10/19           agent       Add register access and report rate APIs.
+// 2026/10/19           agent       Add the object read and the owner data.
+// 2026/10/19           agent       Add the concurrent discovery and the hot-plug check.
+// 2026/10/19           agent       Keep the register overrides, drop the guessed report rates.
+// 2026/10/19           agent       Add the cheap detection of the hot-plug check.
+// 2026/10/19           agent       Restore the report rates with the documented idle times.
 //
 //*****************************************************************************
 #ifndef __PAJ7620_H__
@@ -30,13 +43,106 @@ extern "C"
 
 #include <rtthread.h>
 #include <rtdevice.h>
+#include "paj7620_bus.h"
 
-struct paj7620_device
-{
-    struct rt_i2c_bus_device *i2c;
-    rt_mutex_t lock;
-};
-typedef struct paj7620_device *paj7620_device_t;
+/**< i2c bus clock requested at initialization, 0 keeps the BSP setting.
+ * The clock applies to every device on the bus, only set it when all of
+ * them support it. */
+#ifndef PAJ7620_I2C_CLOCK
+#define PAJ7620_I2C_CLOCK           0
+#endif
+
+/**< clock the BSP runs the bus at, restored when the sensor fails to answer
+ * at PAJ7620_I2C_CLOCK */
+#ifndef PAJ7620_I2C_FALLBACK_CLOCK
+#define PAJ7620_I2C_FALLBACK_CLOCK  100000
+#endif
+
+/**< retries of a failed register transfer before reporting an error */
+#ifndef PAJ7620_I2C_RETRIES
+#define PAJ7620_I2C_RETRIES         2
+#endif
+
+/**< milliseconds a gesture poll may wait for the bus before it is skipped */
+#ifndef PAJ7620_POLL_DEADLINE_MS
+#define PAJ7620_POLL_DEADLINE_MS    10
+#endif
+
+/**< registers written per bus chunk during initialization */
+#ifndef PAJ7620_INIT_CHUNK
+#define PAJ7620_INIT_CHUNK          16
+#endif
+
+/**< delay before the read that tells forward/backward from a direction */
+#ifndef PAJ7620_CONFIRM_DELAY_MS
+#define PAJ7620_CONFIRM_DELAY_MS    1
+#endif
+
+/**< gesture polling period of the engine when no INT pin is wired */
+#ifndef PAJ7620_POLL_PERIOD_MS
+#define PAJ7620_POLL_PERIOD_MS      50
+#endif
+
+/**< gesture events buffered by the engine */
+#ifndef PAJ7620_EVENT_FIFO_SIZE
+#define PAJ7620_EVENT_FIFO_SIZE     8
+#endif
+
+/**< consecutive bus errors after which the engine reinitializes the sensor */
+#ifndef PAJ7620_RECOVERY_ERRORS
+#define PAJ7620_RECOVERY_ERRORS     3
+#endif
+
+/**< registers read per burst when verifying the configuration */
+#ifndef PAJ7620_VERIFY_BURST
+#define PAJ7620_VERIFY_BURST        32
+#endif
+
+/**< period of the engine configuration health check, 0 to disable it */
+#ifndef PAJ7620_HEALTH_CHECK_MS
+#define PAJ7620_HEALTH_CHECK_MS     0
+#endif
+
+/**< R_IDLE_TIME of the normal (120 fps) and gaming (240 fps) report rates, from the PixArt register setting */
+#ifndef PAJ7620_NORMAL_IDLE_TIME
+#define PAJ7620_NORMAL_IDLE_TIME    0x96
+#endif
+
+#ifndef PAJ7620_GAMING_IDLE_TIME
+#define PAJ7620_GAMING_IDLE_TIME    0x12
+#endif
+
+/**< registers written with paj7620_write_bank_reg() kept across reloads */
+#ifndef PAJ7620_OVERRIDES
+#define PAJ7620_OVERRIDES           16
+#endif
+
+/**< workqueue shared by all sensors started without a workqueue */
+#ifndef PAJ7620_WORKQUEUE_STACK
+#define PAJ7620_WORKQUEUE_STACK     1024
+#endif
+
+#ifndef PAJ7620_WORKQUEUE_PRIORITY
+#define PAJ7620_WORKQUEUE_PRIORITY  20
+#endif
+
+/**< threads initializing the sensors of a discovery, one per bus */
+#ifndef PAJ7620_PROBE_STACK
+#define PAJ7620_PROBE_STACK         1024
+#endif
+
+#ifndef PAJ7620_PROBE_PRIORITY
+#define PAJ7620_PROBE_PRIORITY      PAJ7620_WORKQUEUE_PRIORITY
+#endif
+
+/**< period of the hot-plug check, on its own workqueue below the engine */
+#ifndef PAJ7620_HOTPLUG_PERIOD_MS
+#define PAJ7620_HOTPLUG_PERIOD_MS   1000
+#endif
+
+#ifndef PAJ7620_HOTPLUG_PRIORITY
+#define PAJ7620_HOTPLUG_PRIORITY    (PAJ7620_WORKQUEUE_PRIORITY + 1)
+#endif
 
 typedef enum
 {
@@ -52,14 +158,138 @@ typedef enum
     PAJ7620_GESTURE_NONE
 } paj7620_gesture_t;
 
+struct paj7620_gesture_event
+{
+    paj7620_gesture_t type;
+    rt_tick_t timestamp;            /**< tick of the flag read */
+    rt_uint16_t object_size;        /**< object size in pixels at detection */
+    rt_uint8_t speed;               /**< gesture data, relative speed estimate */
+    rt_uint8_t wave_count;          /**< waves counted by the sensor */
+    rt_uint8_t brightness;          /**< object brightness at detection */
+    rt_uint8_t confidence;          /**< 0 - 100, derived from the brightness */
+};
+
+/**< filter stages, applied in this order */
+#define PAJ7620_FILTER_REMAP        (1 << 0)    /**< remap directions of a rotated sensor */
+#define PAJ7620_FILTER_GATE         (1 << 1)    /**< drop dim or small objects */
+#define PAJ7620_FILTER_REPEAT       (1 << 2)    /**< drop repeats of the same gesture */
+#define PAJ7620_FILTER_REFRACTORY   (1 << 3)    /**< drop anything right after a gesture */
+
+struct paj7620_filter_config
+{
+    rt_uint8_t stages;              /**< PAJ7620_FILTER_* stages to run */
+    rt_uint8_t min_brightness;      /**< gate: minimum object brightness */
+    rt_uint16_t min_size;           /**< gate: minimum object size */
+    rt_uint16_t refractory_ms;      /**< refractory: quiet time after a gesture */
+    rt_uint16_t repeat_ms;          /**< repeat: window in which a repeat is dropped */
+    rt_uint8_t remap[PAJ7620_GESTURE_NONE]; /**< remap: reported gesture per detected one,
+                                             *   PAJ7620_GESTURE_NONE drops it */
+};
+
+struct paj7620_filter
+{
+    struct paj7620_filter_config config;
+    rt_tick_t last_seen[PAJ7620_GESTURE_NONE];  /**< last detection per gesture */
+    rt_tick_t last_accepted;                    /**< last gesture let through */
+    rt_uint16_t seen;                           /**< gestures with a valid last_seen */
+    rt_bool_t accepted;                         /**< last_accepted is valid */
+};
+
+typedef enum
+{
+    PAJ7620_RATE_NORMAL,
+    PAJ7620_RATE_GAMING
+} paj7620_rate_t;
+
+struct paj7620_override
+{
+    rt_uint8_t bank;
+    rt_uint8_t addr;
+    rt_uint8_t value;
+};
+
+struct paj7620_device
+{
+    struct rt_i2c_bus_device *i2c;
+    paj7620_bus_t bus;
+    rt_mutex_t lock;
+    rt_uint32_t clock;              /**< bus clock in Hz, 0 if left to the BSP */
+    rt_uint8_t retries;             /**< retries of a failed register transfer */
+    rt_uint8_t bank;                /**< register bank selected on the chip */
+    void *user_data;                /**< owner data, e.g. the sensor framework device */
+    struct paj7620_override overrides[PAJ7620_OVERRIDES];  /**< replayed on every reload */
+    rt_uint8_t override_count;
+
+    /* gesture engine */
+    struct rt_workqueue *wq;
+    struct rt_work poll_work;       /**< reads the flags on INT or poll period */
+    struct rt_work confirm_work;    /**< deferred forward/backward confirmation */
+    struct rt_work health_work;     /**< periodic configuration check */
+    rt_base_t int_pin;              /**< INT pin, -1 when polling */
+    rt_bool_t running;
+    rt_bool_t sleeping;             /**< INT pin armed as deep sleep wake source */
+    struct paj7620_gesture_event pending;   /**< gesture waiting for confirmation */
+    rt_uint8_t errors;              /**< consecutive bus errors */
+    rt_bool_t wave_latched;         /**< wave read along with another gesture, not reported yet */
+    void (*indicate)(struct paj7620_device *dev);
+
+    /* gesture events */
+    struct paj7620_filter filter;
+    struct rt_semaphore event_sem;
+    struct paj7620_gesture_event events[PAJ7620_EVENT_FIFO_SIZE];
+    rt_uint8_t event_head;
+    rt_uint8_t event_count;
+};
+typedef struct paj7620_device *paj7620_device_t;
+
+typedef enum
+{
+    PAJ7620_PROBE_ABSENT,           /**< no sensor answered on the bus */
+    PAJ7620_PROBE_FOUND,            /**< sensor found and initialized by a discovery */
+    PAJ7620_PROBE_ATTACHED,         /**< found sensor taken over by the hot-plug check */
+    PAJ7620_PROBE_LOST              /**< attached sensor stopped answering */
+} paj7620_probe_state_t;
+
+struct paj7620_probe
+{
+    const char *bus_name;           /**< i2c bus or i2c mux channel to probe */
+    paj7620_device_t dev;           /**< sensor on the bus, RT_NULL until found */
+    paj7620_probe_state_t state;
+};
+
 //*****************************************************************************
 //
 // Prototypes for the APIs.
 //
 //*****************************************************************************
 paj7620_device_t paj7620_init(const char *i2c_bus_name);
+rt_err_t paj7620_detect(const char *i2c_bus_name);
 void paj7620_deinit(paj7620_device_t dev);
 rt_err_t paj7620_get_gesture(paj7620_device_t dev, paj7620_gesture_t *gest);
+rt_err_t paj7620_get_gesture_event(paj7620_device_t dev, struct paj7620_gesture_event *event);
+rt_err_t paj7620_read_bank_regs(paj7620_device_t dev, rt_uint8_t bank, rt_uint8_t addr,
+                                rt_uint8_t *data, rt_uint16_t len);
+rt_err_t paj7620_write_bank_reg(paj7620_device_t dev, rt_uint8_t bank, rt_uint8_t addr,
+                                rt_uint8_t data);
+rt_err_t paj7620_get_object(paj7620_device_t dev, rt_uint8_t *brightness, rt_uint16_t *size);
+void paj7620_clear_overrides(paj7620_device_t dev);
+rt_err_t paj7620_set_rate(paj7620_device_t dev, paj7620_rate_t rate);
+rt_err_t paj7620_reload(paj7620_device_t dev);
+rt_err_t paj7620_verify(paj7620_device_t dev, rt_uint16_t *crc);
+rt_err_t paj7620_start(paj7620_device_t dev, struct rt_workqueue *wq, rt_base_t int_pin);
+void paj7620_stop(paj7620_device_t dev);
+rt_err_t paj7620_sleep(paj7620_device_t dev);
+rt_err_t paj7620_wake_event(paj7620_device_t dev);
+void paj7620_set_indicate(paj7620_device_t dev, void (*indicate)(paj7620_device_t dev));
+void paj7620_filter_init(struct paj7620_filter *filter, const struct paj7620_filter_config *config);
+void paj7620_filter_rotate(struct paj7620_filter_config *config, rt_uint16_t degrees);
+rt_bool_t paj7620_filter_apply(struct paj7620_filter *filter, struct paj7620_gesture_event *event);
+void paj7620_set_filter(paj7620_device_t dev, const struct paj7620_filter_config *config);
+rt_err_t paj7620_wait_event(paj7620_device_t dev, struct paj7620_gesture_event *event, rt_int32_t timeout);
+rt_size_t paj7620_discover(struct paj7620_probe *probes, rt_size_t count);
+rt_err_t paj7620_hotplug_start(struct paj7620_probe *probes, rt_size_t count,
+                               void (*notify)(struct paj7620_probe *probe));
+void paj7620_hotplug_stop(void);
 
 //*****************************************************************************
 //
@@ -0,0 +1,357 @@
+//*****************************************************************************
+// file        : paj7620_bus.c
+// shared i2c bus transaction scheduler
+//
+// Transactions are queued per bus with a priority and a deadline. When the
+// bus is released it is handed over to a waiter of the most urgent class,
+// waiters of the same class are served first come first served. Long jobs
+// take the bus for a bounded chunk of transfers and call paj7620_bus_yield()
+// between chunks, which hands the bus over as soon as a more urgent
+// transaction is waiting.
+//
+// Only the transactions going through this scheduler are ordered. Drivers
+// calling rt_i2c_transfer() directly on the same bus still contend on the
+// bus device lock, first come first served, between two scheduled
+// transactions.
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+// 2026/10/19           agent       Hand the bus over by priority class.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup paj7620
+//! @{
+//
+//*****************************************************************************
+#include "paj7620_bus.h"
+
+#define DBG_SECTION_NAME "paj7620.bus"
+#include <rtdbg.h>
+
+#ifdef PKG_USING_PAJ7620
+
+/**< schedulers of all attached buses */
+static rt_list_t paj7620_bus_list = RT_LIST_OBJECT_INIT(paj7620_bus_list);
+
+/**
+ * @brief find the scheduler of an i2c bus
+ *
+ * @param i2c i2c bus device
+ *
+ * @return scheduler handle, RT_NULL if the bus isn't attached
+ */
+static paj7620_bus_t paj7620_bus_find(struct rt_i2c_bus_device *i2c)
+{
+    paj7620_bus_t bus;
+
+    rt_list_for_each_entry(bus, &paj7620_bus_list, list)
+    {
+        if (bus->i2c == i2c)
+        {
+            return bus;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * @brief free a scheduler
+ *
+ * @param bus scheduler handle
+ */
+static void paj7620_bus_free(paj7620_bus_t bus)
+{
+    rt_uint8_t i;
+
+    for (i = 0; i < PAJ7620_BUS_PRIO_MAX; i++)
+    {
+        rt_sem_detach(&bus->handover[i]);
+    }
+
+    rt_free(bus);
+}
+
+/**
+ * @brief attach to the scheduler of an i2c bus, creating it on first use
+ *
+ * @param i2c i2c bus device
+ *
+ * @return scheduler handle
+ */
+paj7620_bus_t paj7620_bus_attach(struct rt_i2c_bus_device *i2c)
+{
+    paj7620_bus_t bus, found;
+    rt_uint8_t i;
+
+    RT_ASSERT(i2c);
+
+    rt_enter_critical();
+    bus = paj7620_bus_find(i2c);
+    if (bus != RT_NULL)
+    {
+        bus->ref++;
+    }
+    rt_exit_critical();
+
+    if (bus != RT_NULL)
+    {
+        return bus;
+    }
+
+    bus = rt_calloc(1, sizeof(struct paj7620_bus));
+
+    if (bus == RT_NULL)
+    {
+        LOG_E("Can't allocate memory for bus scheduler on '%s' ", i2c->parent.parent.name);
+        return RT_NULL;
+    }
+
+    bus->i2c = i2c;
+    bus->ref = 1;
+
+    for (i = 0; i < PAJ7620_BUS_PRIO_MAX; i++)
+    {
+        rt_sem_init(&bus->handover[i], "paj_bus", 0, RT_IPC_FLAG_FIFO);
+    }
+
+    /* somebody may have attached the same bus while we were allocating */
+    rt_enter_critical();
+    found = paj7620_bus_find(i2c);
+    if (found != RT_NULL)
+    {
+        found->ref++;
+    }
+    else
+    {
+        rt_list_insert_before(&paj7620_bus_list, &bus->list);
+    }
+    rt_exit_critical();
+
+    if (found != RT_NULL)
+    {
+        paj7620_bus_free(bus);
+        return found;
+    }
+
+    return bus;
+}
+
+/**
+ * @brief detach from a bus scheduler, freeing it with the last user
+ *
+ * @param bus scheduler handle
+ */
+void paj7620_bus_detach(paj7620_bus_t bus)
+{
+    rt_bool_t last;
+
+    RT_ASSERT(bus);
+
+    rt_enter_critical();
+    last = (--bus->ref == 0);
+    if (last)
+    {
+        rt_list_remove(&bus->list);
+    }
+    rt_exit_critical();
+
+    if (last)
+    {
+        paj7620_bus_free(bus);
+    }
+}
+
+/**
+ * @brief take the bus for a transaction or a chunk of transactions
+ *
+ * The owner may take the bus again, it is released with the last release.
+ *
+ * @param bus scheduler handle
+ * @param prio transaction priority
+ * @param deadline ticks to wait for the bus, RT_WAITING_FOREVER to block
+ *
+ * @return operation result, -RT_ETIMEOUT if the deadline expired
+ */
+rt_err_t paj7620_bus_take(paj7620_bus_t bus, paj7620_bus_prio_t prio, rt_int32_t deadline)
+{
+    rt_thread_t self = rt_thread_self();
+    rt_base_t level;
+    rt_bool_t handed;
+
+    RT_ASSERT(bus);
+    RT_ASSERT(prio < PAJ7620_BUS_PRIO_MAX);
+
+    level = rt_hw_interrupt_disable();
+
+    if (bus->busy && bus->owner == self)
+    {
+        bus->nest++;
+        rt_hw_interrupt_enable(level);
+        return RT_EOK;
+    }
+
+    if (!bus->busy)
+    {
+        bus->busy = RT_TRUE;
+        bus->owner = self;
+        bus->nest = 1;
+        rt_hw_interrupt_enable(level);
+        return RT_EOK;
+    }
+
+    bus->pending[prio]++;
+    rt_hw_interrupt_enable(level);
+
+    if (rt_sem_take(&bus->handover[prio], deadline) != RT_EOK)
+    {
+        level = rt_hw_interrupt_disable();
+
+        /* every waiter of the class still counted hasn't been given the bus,
+         * otherwise the bus is on its way to us and has to be taken */
+        handed = (bus->pending[prio] == 0);
+        if (!handed)
+        {
+            bus->pending[prio]--;
+        }
+        rt_hw_interrupt_enable(level);
+
+        if (!handed)
+        {
+            return -RT_ETIMEOUT;
+        }
+
+        rt_sem_take(&bus->handover[prio], RT_WAITING_FOREVER);
+    }
+
+    level = rt_hw_interrupt_disable();
+    bus->owner = self;
+    bus->nest = 1;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief release the bus, handing it over to the most urgent waiter
+ *
+ * @param bus scheduler handle
+ */
+void paj7620_bus_release(paj7620_bus_t bus)
+{
+    rt_base_t level;
+    rt_uint8_t i;
+
+    RT_ASSERT(bus);
+
+    level = rt_hw_interrupt_disable();
+
+    RT_ASSERT(bus->owner == rt_thread_self());
+
+    if (--bus->nest > 0)
+    {
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
+    bus->owner = RT_NULL;
+
+    for (i = 0; i < PAJ7620_BUS_PRIO_MAX; i++)
+    {
+        if (bus->pending[i])
+        {
+            /* the bus stays busy until the waiter picks it up */
+            bus->pending[i]--;
+            rt_hw_interrupt_enable(level);
+            rt_sem_release(&bus->handover[i]);
+            return;
+        }
+    }
+
+    bus->busy = RT_FALSE;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * @brief hand the bus over if a more urgent transaction is waiting
+ *
+ * Called by long jobs between two chunks. The bus goes to the most urgent
+ * waiter, the job gets it back once no waiter of a higher class than its
+ * own is left.
+ *
+ * @param bus scheduler handle
+ * @param prio priority of the running job
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_bus_yield(paj7620_bus_t bus, paj7620_bus_prio_t prio)
+{
+    rt_uint16_t nest;
+    rt_err_t result;
+    rt_uint8_t i;
+
+    RT_ASSERT(bus);
+
+    for (i = 0; i < prio; i++)
+    {
+        if (bus->pending[i])
+        {
+            nest = bus->nest;
+            bus->nest = 1;
+            paj7620_bus_release(bus);
+
+            result = paj7620_bus_take(bus, prio, RT_WAITING_FOREVER);
+            bus->nest = nest;
+
+            return result;
+        }
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * @brief run an i2c transaction through the scheduler
+ *
+ * @param bus scheduler handle
+ * @param msgs i2c messages of the transaction
+ * @param num number of messages
+ * @param prio transaction priority
+ * @param deadline ticks to wait for the bus, RT_WAITING_FOREVER to block
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_bus_transfer(paj7620_bus_t bus, struct rt_i2c_msg msgs[], rt_uint32_t num,
+                              paj7620_bus_prio_t prio, rt_int32_t deadline)
+{
+    rt_err_t result;
+
+    result = paj7620_bus_take(bus, prio, deadline);
+
+    if (result != RT_EOK)
+    {
+        return result;
+    }
+
+    if (rt_i2c_transfer(bus->i2c, msgs, num) != num)
+    {
+        result = -RT_EIO;
+    }
+
+    paj7620_bus_release(bus);
+
+    return result;
+}
+
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,85 @@
+//*****************************************************************************
+// file        : paj7620_bus.h
+// shared i2c bus transaction scheduler
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+// 2026/10/19           agent       Hand the bus over by priority class.
+//
+//*****************************************************************************
+#ifndef __PAJ7620_BUS_H__
+#define __PAJ7620_BUS_H__
+
+//*****************************************************************************
+//
+//! \addtogroup paj7620
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+typedef enum
+{
+    PAJ7620_BUS_PRIO_URGENT,        /**< latency critical, e.g. gesture polls */
+    PAJ7620_BUS_PRIO_NORMAL,        /**< single register accesses */
+    PAJ7620_BUS_PRIO_BULK,          /**< long jobs split into chunks */
+    PAJ7620_BUS_PRIO_MAX
+} paj7620_bus_prio_t;
+
+struct paj7620_bus
+{
+    rt_list_t list;
+    struct rt_i2c_bus_device *i2c;
+    rt_thread_t owner;              /**< thread holding the bus, RT_NULL while handed over */
+    rt_uint16_t nest;               /**< nested takes of the owner */
+    rt_bool_t busy;                 /**< bus held or being handed over */
+    struct rt_semaphore handover[PAJ7620_BUS_PRIO_MAX]; /**< bus given to a waiter per priority */
+    rt_uint16_t pending[PAJ7620_BUS_PRIO_MAX];  /**< transactions waiting per priority */
+    rt_uint16_t ref;
+};
+typedef struct paj7620_bus *paj7620_bus_t;
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+paj7620_bus_t paj7620_bus_attach(struct rt_i2c_bus_device *i2c);
+void paj7620_bus_detach(paj7620_bus_t bus);
+rt_err_t paj7620_bus_take(paj7620_bus_t bus, paj7620_bus_prio_t prio, rt_int32_t deadline);
+void paj7620_bus_release(paj7620_bus_t bus);
+rt_err_t paj7620_bus_yield(paj7620_bus_t bus, paj7620_bus_prio_t prio);
+rt_err_t paj7620_bus_transfer(paj7620_bus_t bus, struct rt_i2c_msg msgs[], rt_uint32_t num,
+                              paj7620_bus_prio_t prio, rt_int32_t deadline);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+#endif //  __PAJ7620_BUS_H__
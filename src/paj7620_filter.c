@@ -0,0 +1,183 @@
+//*****************************************************************************
+// file        : paj7620_filter.c
+// paj7620 gesture filter pipeline
+//
+// The filter runs on every decoded gesture event before it is handed to the
+// application. The stages are selected once with paj7620_filter_init(), keep
+// their state in fixed size arrays and run in constant time per event.
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+// 2026/10/19           agent       Drop the gestures remapped to PAJ7620_GESTURE_NONE.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup paj7620
+//! @{
+//
+//*****************************************************************************
+#include "paj7620.h"
+
+#ifdef PKG_USING_PAJ7620
+
+/**< directions in clockwise order, used to rotate the remap table */
+static const rt_uint8_t paj7620_directions[] =
+{
+    PAJ7620_GESTURE_UP,
+    PAJ7620_GESTURE_RIGHT,
+    PAJ7620_GESTURE_DOWN,
+    PAJ7620_GESTURE_LEFT,
+};
+
+/**
+ * @brief initialize a filter with the given stages
+ *
+ * @param filter filter to initialize
+ * @param config filter configuration, RT_NULL to let every gesture through
+ */
+void paj7620_filter_init(struct paj7620_filter *filter, const struct paj7620_filter_config *config)
+{
+    rt_uint8_t i;
+
+    RT_ASSERT(filter);
+
+    rt_memset(filter, 0, sizeof(struct paj7620_filter));
+
+    if (config != RT_NULL)
+    {
+        filter->config = *config;
+    }
+
+    for (i = 0; i < PAJ7620_GESTURE_NONE; i++)
+    {
+        if (!(filter->config.stages & PAJ7620_FILTER_REMAP))
+        {
+            filter->config.remap[i] = i;
+        }
+        else if (filter->config.remap[i] > PAJ7620_GESTURE_NONE)
+        {
+            /* anything out of range drops the gesture like NONE */
+            filter->config.remap[i] = PAJ7620_GESTURE_NONE;
+        }
+    }
+}
+
+/**
+ * @brief fill the remap table for a sensor mounted rotated clockwise
+ *
+ * @param config filter configuration to update
+ * @param degrees rotation of the sensor, a multiple of 90
+ */
+void paj7620_filter_rotate(struct paj7620_filter_config *config, rt_uint16_t degrees)
+{
+    rt_uint8_t i, steps;
+
+    RT_ASSERT(config);
+    RT_ASSERT((degrees % 90) == 0);
+
+    steps = (degrees / 90) % 4;
+
+    for (i = 0; i < PAJ7620_GESTURE_NONE; i++)
+    {
+        config->remap[i] = i;
+    }
+
+    /* e.g. turned by 90 degrees, a swipe along the sensor's own up axis is
+     * a swipe to the right for the user */
+    for (i = 0; i < 4; i++)
+    {
+        config->remap[paj7620_directions[i]] = paj7620_directions[(i + steps) % 4];
+    }
+
+    config->stages |= PAJ7620_FILTER_REMAP;
+}
+
+/**
+ * @brief check whether a tick lies within a window after a reference tick
+ *
+ * @param now current tick
+ * @param ref reference tick
+ * @param ms window length
+ *
+ * @return RT_TRUE if now is less than ms after ref
+ */
+static rt_bool_t paj7620_filter_within(rt_tick_t now, rt_tick_t ref, rt_uint16_t ms)
+{
+    return (rt_tick_t)(now - ref) < rt_tick_from_millisecond(ms);
+}
+
+/**
+ * @brief run a gesture event through the filter
+ *
+ * @param filter filter handle
+ * @param event gesture event, remapped in place
+ *
+ * @return RT_TRUE if the event is let through, RT_FALSE if it is dropped
+ */
+rt_bool_t paj7620_filter_apply(struct paj7620_filter *filter, struct paj7620_gesture_event *event)
+{
+    const struct paj7620_filter_config *config;
+    rt_bool_t repeat;
+    rt_uint8_t type;
+
+    RT_ASSERT(filter);
+    RT_ASSERT(event);
+
+    config = &filter->config;
+
+    if (event->type >= PAJ7620_GESTURE_NONE)
+    {
+        return RT_FALSE;
+    }
+
+    type = config->remap[event->type];
+
+    /* remapped to PAJ7620_GESTURE_NONE: dropped */
+    if (type >= PAJ7620_GESTURE_NONE)
+    {
+        return RT_FALSE;
+    }
+
+    event->type = (paj7620_gesture_t)type;
+
+    if ((config->stages & PAJ7620_FILTER_GATE) &&
+        (event->brightness < config->min_brightness || event->object_size < config->min_size))
+    {
+        return RT_FALSE;
+    }
+
+    /* a flickering gesture keeps being dropped until it has been quiet for
+     * a whole window, hence the detection time is kept even when dropped */
+    repeat = (filter->seen & (1 << type)) &&
+             paj7620_filter_within(event->timestamp, filter->last_seen[type], config->repeat_ms);
+    filter->last_seen[type] = event->timestamp;
+    filter->seen |= (1 << type);
+
+    if ((config->stages & PAJ7620_FILTER_REPEAT) && repeat)
+    {
+        return RT_FALSE;
+    }
+
+    if ((config->stages & PAJ7620_FILTER_REFRACTORY) && filter->accepted &&
+        paj7620_filter_within(event->timestamp, filter->last_accepted, config->refractory_ms))
+    {
+        return RT_FALSE;
+    }
+
+    filter->last_accepted = event->timestamp;
+    filter->accepted = RT_TRUE;
+
+    return RT_TRUE;
+}
+
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
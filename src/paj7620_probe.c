@@ -0,0 +1,352 @@
+//*****************************************************************************
+// file        : paj7620_probe.c
+// paj7620 discovery and hot-plug check
+//
+// A discovery initializes the sensors of several buses at once, one thread
+// per bus, so that the init bursts of the buses overlap and bringing up N
+// sensors takes about as long as the slowest bus. The hot-plug check looks
+// for a sensor on the buses still empty every PAJ7620_HOTPLUG_PERIOD_MS, with
+// a part id read that leaves the bus clock alone, runs a discovery of the
+// buses that answered and reinitializes the sensors that come back after
+// being lost. An attached sensor must answer its part id and still hold its
+// configuration, a sensor reset by a brown-out is reinitialized in place.
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+// 2026/10/19           agent       Only initialize the empty buses where a sensor answers.
+// 2026/10/19           agent       Check the part id and the configuration of the attached sensors.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup paj7620
+//! @{
+//
+//*****************************************************************************
+#include "paj7620.h"
+
+#define DBG_SECTION_NAME "paj7620.probe"
+#include <rtdbg.h>
+
+#ifdef PKG_USING_PAJ7620
+
+/**< one bus of a discovery */
+struct paj7620_probe_job
+{
+    struct paj7620_probe *probe;
+    struct rt_semaphore *done;
+};
+
+/**< state of the hot-plug check */
+static struct
+{
+    struct paj7620_probe *probes;
+    rt_size_t count;
+    void (*notify)(struct paj7620_probe *probe);
+    struct rt_workqueue *wq;
+    struct rt_work work;
+    rt_bool_t running;
+} paj7620_hotplug;
+
+/**
+ * @brief initialize the sensor of one probe
+ *
+ * @param probe probe entry
+ */
+static void paj7620_probe_one(struct paj7620_probe *probe)
+{
+    probe->dev = paj7620_init(probe->bus_name);
+    probe->state = (probe->dev != RT_NULL) ? PAJ7620_PROBE_FOUND : PAJ7620_PROBE_ABSENT;
+}
+
+/**
+ * @brief thread initializing the sensor of one bus
+ *
+ * @param parameter discovery job
+ */
+static void paj7620_probe_entry(void *parameter)
+{
+    struct paj7620_probe_job *job = (struct paj7620_probe_job *)parameter;
+
+    paj7620_probe_one(job->probe);
+    rt_sem_release(job->done);
+}
+
+/**
+ * @brief initialize the sensors of several buses concurrently
+ *
+ * @param probes buses to probe, dev and state are updated
+ * @param count number of entries
+ * @param detect only initialize the buses where paj7620_detect() finds a sensor
+ *
+ * @return number of sensors found
+ */
+static rt_size_t paj7620_discover_run(struct paj7620_probe *probes, rt_size_t count,
+                                      rt_bool_t detect)
+{
+    struct paj7620_probe_job *jobs = RT_NULL;
+    struct rt_semaphore done;
+    rt_size_t i, started = 0, found = 0;
+    rt_thread_t thread;
+
+    rt_sem_init(&done, "paj_prb", 0, RT_IPC_FLAG_FIFO);
+
+    for (i = 0; i < count; i++)
+    {
+        if (probes[i].dev != RT_NULL)
+        {
+            continue;
+        }
+
+        if (detect && paj7620_detect(probes[i].bus_name) != RT_EOK)
+        {
+            probes[i].state = PAJ7620_PROBE_ABSENT;
+            continue;
+        }
+
+        /* nothing is allocated while the buses stay empty */
+        if (jobs == RT_NULL)
+        {
+            jobs = rt_calloc(count, sizeof(struct paj7620_probe_job));
+        }
+
+        thread = RT_NULL;
+
+        if (jobs != RT_NULL)
+        {
+            jobs[started].probe = &probes[i];
+            jobs[started].done = &done;
+            thread = rt_thread_create("paj_prb", paj7620_probe_entry, &jobs[started],
+                                      PAJ7620_PROBE_STACK, PAJ7620_PROBE_PRIORITY, 10);
+        }
+
+        if (thread != RT_NULL)
+        {
+            rt_thread_startup(thread);
+            started++;
+        }
+        else
+        {
+            paj7620_probe_one(&probes[i]);
+        }
+    }
+
+    while (started--)
+    {
+        rt_sem_take(&done, RT_WAITING_FOREVER);
+    }
+
+    rt_sem_detach(&done);
+    rt_free(jobs);
+
+    for (i = 0; i < count; i++)
+    {
+        if (probes[i].state == PAJ7620_PROBE_FOUND)
+        {
+            LOG_I("paj7620 found on '%s'", probes[i].bus_name);
+            found++;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief probe and initialize the sensors of several buses concurrently
+ *
+ * Every entry without a device is probed by its own thread, the entries
+ * already holding a device are left alone. An i2c mux channel is probed like
+ * any other bus by the name of its bus device. Falls back to probing in the
+ * calling thread when no thread can be created.
+ *
+ * @param probes buses to probe, dev and state are updated
+ * @param count number of entries
+ *
+ * @return number of sensors found by this discovery
+ */
+rt_size_t paj7620_discover(struct paj7620_probe *probes, rt_size_t count)
+{
+    RT_ASSERT(probes);
+
+    return paj7620_discover_run(probes, count, RT_FALSE);
+}
+
+/**
+ * @brief report a state change of a probe entry
+ *
+ * @param probe probe entry
+ * @param state new state
+ */
+static void paj7620_hotplug_set(struct paj7620_probe *probe, paj7620_probe_state_t state)
+{
+    probe->state = state;
+
+    if (paj7620_hotplug.notify)
+    {
+        paj7620_hotplug.notify(probe);
+    }
+}
+
+/**
+ * @brief work item of the hot-plug check
+ *
+ * @param work work item
+ * @param work_data not used
+ */
+static void paj7620_hotplug_work(struct rt_work *work, void *work_data)
+{
+    struct paj7620_probe *probe;
+    rt_uint8_t id[2];
+    rt_err_t result;
+    rt_size_t i;
+
+    /* the sensors plugged in since the last check come up together */
+    paj7620_discover_run(paj7620_hotplug.probes, paj7620_hotplug.count, RT_TRUE);
+
+    for (i = 0; i < paj7620_hotplug.count; i++)
+    {
+        probe = &paj7620_hotplug.probes[i];
+
+        switch (probe->state)
+        {
+        case PAJ7620_PROBE_FOUND:
+            paj7620_hotplug_set(probe, PAJ7620_PROBE_ATTACHED);
+            break;
+
+        case PAJ7620_PROBE_ATTACHED:
+            result = paj7620_read_bank_regs(probe->dev, 0, 0x00, id, 2);
+
+            if (result == RT_EOK && (id[0] != 0x20 || id[1] != 0x76))
+            {
+                result = RT_ERROR;
+            }
+
+            /* a brown-out keeps the sensor answering with its power-on setting */
+            if (result == RT_EOK)
+            {
+                result = paj7620_verify(probe->dev, RT_NULL);
+
+                if (result == RT_ERROR)
+                {
+                    LOG_W("paj7620 on '%s' lost its configuration", probe->bus_name);
+                    result = paj7620_reload(probe->dev);
+
+                    if (result == RT_EOK)
+                    {
+                        paj7620_hotplug_set(probe, PAJ7620_PROBE_ATTACHED);
+                    }
+                }
+            }
+
+            if (result != RT_EOK)
+            {
+                LOG_W("paj7620 on '%s' lost", probe->bus_name);
+                paj7620_hotplug_set(probe, PAJ7620_PROBE_LOST);
+            }
+            break;
+
+        case PAJ7620_PROBE_LOST:
+            /* a sensor plugged back in starts from its power-on defaults */
+            if (paj7620_reload(probe->dev) == RT_EOK)
+            {
+                LOG_I("paj7620 on '%s' is back, reinitialized", probe->bus_name);
+                paj7620_hotplug_set(probe, PAJ7620_PROBE_ATTACHED);
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (paj7620_hotplug.running)
+    {
+        rt_workqueue_submit_work(paj7620_hotplug.wq, &paj7620_hotplug.work,
+                                 rt_tick_from_millisecond(PAJ7620_HOTPLUG_PERIOD_MS));
+    }
+}
+
+/**
+ * @brief start the hot-plug check of a set of buses
+ *
+ * The sensors found before the start are taken as known to the caller, the
+ * notify callback only reports the later changes. It runs on the hot-plug
+ * workqueue, the devices of the entries must not be freed while the check
+ * is running.
+ *
+ * @param probes buses to watch, usually the ones given to paj7620_discover()
+ * @param count number of entries
+ * @param notify callback on every attached, lost or reinitialized sensor, may be RT_NULL
+ *
+ * @return operation result
+ */
+rt_err_t paj7620_hotplug_start(struct paj7620_probe *probes, rt_size_t count,
+                               void (*notify)(struct paj7620_probe *probe))
+{
+    rt_size_t i;
+
+    RT_ASSERT(probes);
+
+    if (paj7620_hotplug.running)
+    {
+        return -RT_EBUSY;
+    }
+
+    if (paj7620_hotplug.wq == RT_NULL)
+    {
+        paj7620_hotplug.wq = rt_workqueue_create("paj_hp", PAJ7620_WORKQUEUE_STACK,
+                                                 PAJ7620_HOTPLUG_PRIORITY);
+
+        if (paj7620_hotplug.wq == RT_NULL)
+        {
+            LOG_E("Can't create workqueue for paj7620 hot-plug");
+            return -RT_ENOMEM;
+        }
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (probes[i].state == PAJ7620_PROBE_FOUND)
+        {
+            probes[i].state = PAJ7620_PROBE_ATTACHED;
+        }
+    }
+
+    paj7620_hotplug.probes = probes;
+    paj7620_hotplug.count = count;
+    paj7620_hotplug.notify = notify;
+    paj7620_hotplug.running = RT_TRUE;
+    rt_work_init(&paj7620_hotplug.work, paj7620_hotplug_work, RT_NULL);
+
+    rt_workqueue_submit_work(paj7620_hotplug.wq, &paj7620_hotplug.work,
+                             rt_tick_from_millisecond(PAJ7620_HOTPLUG_PERIOD_MS));
+
+    return RT_EOK;
+}
+
+/**
+ * @brief stop the hot-plug check
+ *
+ * Must not be called from the notify callback.
+ */
+void paj7620_hotplug_stop(void)
+{
+    if (!paj7620_hotplug.running)
+    {
+        return;
+    }
+
+    paj7620_hotplug.running = RT_FALSE;
+    rt_workqueue_cancel_work_sync(paj7620_hotplug.wq, &paj7620_hotplug.work);
+}
+
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,322 @@
+//*****************************************************************************
+// file        : sensor_pixart_paj7620.c
+// paj7620 sensor framework device
+//
+// The sensor is registered as two sensor framework devices sharing one
+// paj7620 device: a gesture channel supporting the polling, interrupt and
+// fifo modes, and a polled proximity channel reporting the object
+// brightness. In the interrupt and fifo modes the INT pin is served by the
+// driver engine, a single rt_device_read() drains every queued gesture.
+//
+// The framework has no gesture class: the gesture channel is registered as
+// RT_SENSOR_CLASS_NONE, named "none" followed by the sensor name, and a
+// sample carries a paj7620_gesture_t in data.step. The proximity channel is
+// named "pr_" followed by the sensor name.
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+// 2026/10/19           agent       Document the registered device names.
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! \addtogroup paj7620
+//! @{
+//
+//*****************************************************************************
+#include "paj7620.h"
+
+#if defined(PKG_USING_PAJ7620) && defined(PAJ7620_USING_SENSOR)
+#include "sensor_pixart_paj7620.h"
+
+#define DBG_SECTION_NAME "sensor.paj7620"
+#include <rtdbg.h>
+
+/**
+ * @brief convert a gesture event into a sensor sample
+ *
+ * @param data sensor sample
+ * @param event gesture event
+ */
+static void paj7620_sensor_fill(struct rt_sensor_data *data, const struct paj7620_gesture_event *event)
+{
+    data->type = RT_SENSOR_CLASS_NONE;
+    data->data.step = event->type;
+    data->timestamp = (rt_uint32_t)((rt_uint64_t)event->timestamp * 1000 / RT_TICK_PER_SECOND);
+}
+
+/**
+ * @brief read gestures from the gesture channel
+ *
+ * @param sensor sensor device
+ * @param data sensor samples
+ * @param len number of samples in the buffer
+ *
+ * @return number of samples read
+ */
+static rt_size_t paj7620_fetch_gesture(rt_sensor_t sensor, struct rt_sensor_data *data, rt_size_t len)
+{
+    paj7620_device_t dev = (paj7620_device_t)sensor->config.intf.user_data;
+    struct paj7620_gesture_event event;
+    rt_size_t count = 0;
+
+    if (sensor->config.mode == RT_SENSOR_MODE_POLLING)
+    {
+        if (paj7620_get_gesture_event(dev, &event) != RT_EOK || event.type == PAJ7620_GESTURE_NONE)
+        {
+            return 0;
+        }
+
+        paj7620_sensor_fill(data, &event);
+
+        return 1;
+    }
+
+    while (count < len && paj7620_wait_event(dev, &event, RT_WAITING_NO) == RT_EOK)
+    {
+        paj7620_sensor_fill(&data[count++], &event);
+    }
+
+    return count;
+}
+
+/**
+ * @brief read the proximity channel
+ *
+ * @param sensor sensor device
+ * @param data sensor sample
+ *
+ * @return number of samples read
+ */
+static rt_size_t paj7620_fetch_proximity(rt_sensor_t sensor, struct rt_sensor_data *data)
+{
+    paj7620_device_t dev = (paj7620_device_t)sensor->config.intf.user_data;
+    rt_uint8_t brightness;
+
+    if (paj7620_get_object(dev, &brightness, RT_NULL) != RT_EOK)
+    {
+        return 0;
+    }
+
+    data->type = RT_SENSOR_CLASS_PROXIMITY;
+    data->data.proximity = brightness;
+    data->timestamp = rt_sensor_get_ts();
+
+    return 1;
+}
+
+/**
+ * @brief sensor framework fetch operation
+ *
+ * @param sensor sensor device
+ * @param buf sample buffer
+ * @param len number of samples in the buffer
+ *
+ * @return number of samples read
+ */
+static rt_size_t paj7620_fetch_data(struct rt_sensor_device *sensor, void *buf, rt_size_t len)
+{
+    if (sensor->info.type == RT_SENSOR_CLASS_PROXIMITY)
+    {
+        return paj7620_fetch_proximity(sensor, (struct rt_sensor_data *)buf);
+    }
+
+    return paj7620_fetch_gesture(sensor, (struct rt_sensor_data *)buf, len);
+}
+
+/**
+ * @brief tell the framework that gestures have been queued
+ *
+ * @param dev device handle
+ */
+static void paj7620_sensor_indicate(paj7620_device_t dev)
+{
+    rt_sensor_t sensor = (rt_sensor_t)dev->user_data;
+
+    if (sensor->parent.rx_indicate == RT_NULL)
+    {
+        return;
+    }
+
+    if (sensor->config.mode == RT_SENSOR_MODE_FIFO)
+    {
+        sensor->parent.rx_indicate(&sensor->parent, dev->event_count);
+    }
+    else
+    {
+        sensor->parent.rx_indicate(&sensor->parent, 1);
+    }
+}
+
+/**
+ * @brief sensor framework control operation
+ *
+ * @param sensor sensor device
+ * @param cmd control command
+ * @param args command argument
+ *
+ * @return operation result
+ */
+static rt_err_t paj7620_control(struct rt_sensor_device *sensor, int cmd, void *args)
+{
+    paj7620_device_t dev = (paj7620_device_t)sensor->config.intf.user_data;
+    rt_err_t result;
+
+    switch (cmd)
+    {
+    case RT_SENSOR_CTRL_GET_ID:
+        /* low byte of the part id, 0x20 */
+        return paj7620_read_bank_regs(dev, 0, 0x00, (rt_uint8_t *)args, 1);
+
+    case RT_SENSOR_CTRL_SET_MODE:
+        if (sensor->info.type == RT_SENSOR_CLASS_PROXIMITY)
+        {
+            return ((rt_uint32_t)(rt_ubase_t)args == RT_SENSOR_MODE_POLLING) ? RT_EOK : -RT_EINVAL;
+        }
+
+        if ((rt_uint32_t)(rt_ubase_t)args == RT_SENSOR_MODE_POLLING)
+        {
+            paj7620_stop(dev);
+            return RT_EOK;
+        }
+
+        paj7620_set_indicate(dev, paj7620_sensor_indicate);
+        result = paj7620_start(dev, RT_NULL, dev->int_pin);
+
+        return (result == -RT_EBUSY) ? RT_EOK : result;
+
+    case RT_SENSOR_CTRL_SET_POWER:
+        return RT_EOK;
+
+    case RT_SENSOR_CTRL_SELF_TEST:
+        return paj7620_verify(dev, RT_NULL);
+
+    default:
+        return -RT_ENOSYS;
+    }
+}
+
+static struct rt_sensor_ops paj7620_ops =
+{
+    paj7620_fetch_data,
+    paj7620_control
+};
+
+/**
+ * @brief allocate and register one channel
+ *
+ * @param name sensor name
+ * @param cfg sensor configuration
+ * @param dev device handle
+ * @param type sensor class of the channel
+ * @param flag supported open modes
+ *
+ * @return sensor device, RT_NULL on failure
+ */
+static rt_sensor_t paj7620_sensor_register(const char *name, struct rt_sensor_config *cfg,
+                                           paj7620_device_t dev, rt_uint8_t type, rt_uint32_t flag)
+{
+    rt_sensor_t sensor;
+
+    sensor = rt_calloc(1, sizeof(struct rt_sensor_device));
+
+    if (sensor == RT_NULL)
+    {
+        LOG_E("Can't allocate memory for paj7620 sensor '%s' ", name);
+        return RT_NULL;
+    }
+
+    sensor->info.type = type;
+    sensor->info.vendor = RT_SENSOR_VENDOR_UNKNOWN;
+    sensor->info.model = "paj7620";
+    sensor->info.unit = RT_SENSOR_UNIT_NONE;
+    sensor->info.intf_type = RT_SENSOR_INTF_I2C;
+    sensor->info.range_max = (type == RT_SENSOR_CLASS_PROXIMITY) ? 255 : PAJ7620_GESTURE_WAVE;
+    sensor->info.range_min = 0;
+    sensor->info.period_min = PAJ7620_POLL_PERIOD_MS;
+    sensor->info.fifo_max = PAJ7620_EVENT_FIFO_SIZE;
+
+    rt_memcpy(&sensor->config, cfg, sizeof(struct rt_sensor_config));
+    sensor->config.intf.user_data = dev;
+
+    /* the INT pin is served by the driver engine, not by the framework */
+    sensor->config.irq_pin.pin = RT_PIN_NONE;
+
+    sensor->ops = &paj7620_ops;
+
+    if (rt_hw_sensor_register(sensor, name, flag, RT_NULL) != RT_EOK)
+    {
+        LOG_E("Can't register paj7620 sensor '%s' ", name);
+        rt_free(sensor);
+        return RT_NULL;
+    }
+
+    return sensor;
+}
+
+/**
+ * @brief initialize the paj7620 and register its sensor framework devices
+ *
+ * Registers the gesture channel as PAJ7620_SENSOR_GESTURE_PREFIX and the
+ * proximity channel as PAJ7620_SENSOR_PROXIMITY_PREFIX followed by name.
+ *
+ * @param name sensor name, short enough to fit RT_NAME_MAX with the prefixes
+ * @param cfg sensor configuration, intf.dev_name is the i2c bus name and
+ *            irq_pin.pin the pin wired to INT, or RT_PIN_NONE to poll
+ *
+ * @return operation result
+ */
+int rt_hw_paj7620_init(const char *name, struct rt_sensor_config *cfg)
+{
+    paj7620_device_t dev;
+    rt_sensor_t gesture, proximity;
+
+    RT_ASSERT(name);
+    RT_ASSERT(cfg);
+
+    dev = paj7620_init(cfg->intf.dev_name);
+
+    if (dev == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    dev->int_pin = (cfg->irq_pin.pin == RT_PIN_NONE) ? -1 : cfg->irq_pin.pin;
+
+    gesture = paj7620_sensor_register(name, cfg, dev, RT_SENSOR_CLASS_NONE,
+                                      RT_DEVICE_FLAG_RDONLY | RT_DEVICE_FLAG_INT_RX | RT_DEVICE_FLAG_FIFO_RX);
+
+    if (gesture == RT_NULL)
+    {
+        paj7620_deinit(dev);
+        return -RT_ERROR;
+    }
+
+    proximity = paj7620_sensor_register(name, cfg, dev, RT_SENSOR_CLASS_PROXIMITY,
+                                        RT_DEVICE_FLAG_RDONLY);
+
+    if (proximity == RT_NULL)
+    {
+        rt_device_unregister(&gesture->parent);
+        rt_free(gesture);
+        paj7620_deinit(dev);
+        return -RT_ERROR;
+    }
+
+    dev->user_data = gesture;
+
+    LOG_I("paj7620 sensor '%s' registered", name);
+
+    return RT_EOK;
+}
+
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
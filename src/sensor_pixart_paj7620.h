@@ -0,0 +1,73 @@
+//*****************************************************************************
+// file        : sensor_pixart_paj7620.h
+// paj7620 sensor framework device
+//
+// Change Logs:
+// Date                 Author      Note
+// 2026/10/19           agent       First draft version
+// 2026/10/19           agent       Document the registered device names.
+//
+//*****************************************************************************
+#ifndef __SENSOR_PIXART_PAJ7620_H__
+#define __SENSOR_PIXART_PAJ7620_H__
+
+//*****************************************************************************
+//
+//! \addtogroup paj7620
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "sensor.h"
+#include "paj7620.h"
+
+/**
+ * The framework names a device after its sensor class, rt_hw_paj7620_init("paj", &cfg)
+ * registers "nonepaj" and "pr_paj". The sensor framework has no gesture class, the
+ * gesture channel is of class RT_SENSOR_CLASS_NONE and its prefix has no underscore.
+ * The names are cut to RT_NAME_MAX - 1 characters, keep the name short.
+ */
+#define PAJ7620_SENSOR_GESTURE_PREFIX   "none"  /**< name prefix of the gesture channel */
+#define PAJ7620_SENSOR_PROXIMITY_PREFIX "pr_"   /**< name prefix of the proximity channel */
+
+/**
+ * The value of a gesture sample is a paj7620_gesture_t, not a step count: data.step
+ * is only the field of the sample union it is carried in.
+ */
+#define PAJ7620_SENSOR_GESTURE(sample)  ((paj7620_gesture_t)(sample)->data.step)
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+int rt_hw_paj7620_init(const char *name, struct rt_sensor_config *cfg);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+
+#ifdef __cplusplus
+}
+#endif
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+#endif //  __SENSOR_PIXART_PAJ7620_H__